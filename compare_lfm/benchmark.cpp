@@ -399,6 +399,49 @@ static BenchResult bench_atan2() {
             "All 4 quadrants", "65536-pt, 5 radii x 360 deg"};
 }
 
+/* Phase extraction from IQ samples: raw 12-bit ADC counts (no radix),
+ * amplitude 64..2047, pseudo-random phase. atan2 is scale-invariant, so
+ * both libraries take the integer pairs as-is. */
+static BenchResult bench_atan2_iq() {
+    int n = N_ACCURACY;
+    std::vector<int32_t> x_in(n), y_in(n);
+    uint32_t seed = 12345;
+    for (int i = 0; i < n; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        double amp = 64.0 + (double)(seed >> 21);
+        double ph  = 2.0 * M_PI * (double)(seed & 0xffff) / 65536.0;
+        x_in[i] = (int32_t)std::lround(amp * std::cos(ph));
+        y_in[i] = (int32_t)std::lround(amp * std::sin(ph));
+    }
+
+    std::vector<double> ref(n);
+    for (int i = 0; i < n; i++)
+        ref[i] = std::atan2((double)y_in[i], (double)x_in[i]);
+
+    std::vector<int32_t> fr_out(n), lfm_out(n);
+    for (int i = 0; i < n; i++) fr_out[i] = FR_atan2(y_in[i], x_in[i], RADIX);
+    for (int i = 0; i < n; i++) lfm_out[i] = fix16_atan2(y_in[i], x_in[i]);
+
+    int ti = 0;
+    double fr_ns  = time_fn([&]{ int j = ti++ % n; return FR_atan2(y_in[j], x_in[j], RADIX); });
+    ti = 0;
+    double lfm_ns = time_fn([&]{ int j = ti++ % n; return fix16_atan2(y_in[j], x_in[j]); });
+
+    return {"atan2 (IQ)", "std::atan2", fr_ns, lfm_ns,
+            compute_errors(ref, fr_out), compute_errors(ref, lfm_out),
+            "Integer IQ pairs, phase out", "65536-pt, 12-bit ADC counts"};
+}
+
+/* FR_sqrt and FR_hypot share one integer square root. The default is the
+ * digit-by-digit loop; for the before/after comparison build with the
+ * table-seeded Newton engine instead:  make run FR_DEFS=-DFR_SQRT_NEWTON
+ * (same results; ~6x faster sqrt, ~4x faster hypot on x86-64). */
+#ifdef FR_SQRT_NEWTON
+#define FR_SQRT_ENGINE_NOTE "isqrt: table seed + Newton (FR_SQRT_NEWTON)"
+#else
+#define FR_SQRT_ENGINE_NOTE "isqrt: digit-by-digit"
+#endif
+
 static BenchResult bench_sqrt() {
     auto inputs = make_pos_inputs(N_ACCURACY);
     int n = N_ACCURACY;
@@ -418,7 +461,7 @@ static BenchResult bench_sqrt() {
 
     return {"sqrt", "std::sqrt", fr_ns, lfm_ns,
             compute_errors(ref, fr_out), compute_errors(ref, lfm_out),
-            {}, "65536-pt, [0.01, 100]"};
+            FR_SQRT_ENGINE_NOTE, "65536-pt, [0.01, 100]"};
 }
 
 static BenchResult bench_exp() {
@@ -465,6 +508,15 @@ static BenchResult bench_log() {
             {}, "65536-pt, [0.01, 100]"};
 }
 
+/* FR_log2 (and FR_ln / FR_log10 through it) finds the leading bit with
+ * the compiler's CLZ builtin. For the before/after comparison build with
+ * the portable bit scan instead:  make run FR_DEFS=-DFR_NO_BUILTIN_CLZ */
+#ifdef FR_NO_BUILTIN_CLZ
+#define FR_LOG2_MSB_NOTE "leading bit: portable scan (FR_NO_BUILTIN_CLZ)"
+#else
+#define FR_LOG2_MSB_NOTE "leading bit: CLZ builtin"
+#endif
+
 static BenchResult bench_log2() {
     auto inputs = make_pos_inputs(N_ACCURACY);
     int n = N_ACCURACY;
@@ -484,7 +536,7 @@ static BenchResult bench_log2() {
 
     return {"log2", "std::log2", fr_ns, lfm_ns,
             compute_errors(ref, fr_out), compute_errors(ref, lfm_out),
-            {}, "65536-pt, [0.01, 100]"};
+            FR_LOG2_MSB_NOTE, "65536-pt, [0.01, 100]"};
 }
 
 static BenchResult bench_mul() {
@@ -560,7 +612,7 @@ static BenchResult bench_hypot() {
 
     return {"hypot", "std::hypot", fr_ns, -1,
             compute_errors(ref, fr_out), lfm_err,
-            "FR_math only (libfixmath has no hypot)", "65536-pt, 5 radii x 360 deg"};
+            "FR_math only (libfixmath has no hypot); " FR_SQRT_ENGINE_NOTE, "65536-pt, 5 radii x 360 deg"};
 }
 
 static BenchResult bench_hypot_fast8() {
@@ -585,6 +637,467 @@ static BenchResult bench_hypot_fast8() {
             "FR_math only; shift-only, no multiply", "65536-pt, 5 radii x 360 deg"};
 }
 
+/* --- Array (batch) kernels: ns per element, FR_math only --- */
+
+/* Time a block kernel that processes n elements per call.
+ * Runs enough calls to cover ~N_TIMING elements; min of 3 passes. */
+template<typename Fn>
+static double time_block_fn(Fn fn, int n) {
+    int reps = N_TIMING / n + 1;
+    for (int i = 0; i < reps; i++) fn();   /* warm-up */
+
+    double best = 1e18;
+    for (int pass = 0; pass < 3; pass++) {
+        int64_t t0 = now_ns();
+        for (int i = 0; i < reps; i++) fn();
+        int64_t t1 = now_ns();
+        double ns = (double)(t1 - t0) / ((double)reps * n);
+        if (ns < best) best = ns;
+    }
+    return best;
+}
+
+typedef void (*bam_array_fn)(const u16 *, s32 *, u32);
+
+/* One row: a BAM array kernel timed per element, accuracy vs the double
+ * reference over all 65536 BAM angles. tan skips |ref| > 100 (poles). */
+static BenchResult bench_bam_array(const char *name, const char *gold,
+                                   bam_array_fn fn, double (*ref_fn)(double),
+                                   const char *note) {
+    int n = 65536;
+    std::vector<u16> bam(n);
+    for (int i = 0; i < n; i++) bam[i] = (u16)i;
+
+    std::vector<int32_t> out(n);
+    fn(bam.data(), out.data(), (u32)n);
+
+    std::vector<double> ref;
+    std::vector<int32_t> got;
+    for (int i = 0; i < n; i++) {
+        double r = ref_fn(2.0 * M_PI * i / 65536.0);
+        if (std::fabs(r) > 100.0) continue;
+        ref.push_back(r);
+        got.push_back(out[i]);
+    }
+
+    int blk = 1024;
+    int off = 0;
+    double fr_ns = time_block_fn([&]{
+        fn(bam.data() + off, out.data() + off, (u32)blk);
+        sink = out[off];
+        off = (off + blk) & (n - 1);
+    }, blk);
+
+    ErrorStats lfm_err = {};
+    return {name, gold, fr_ns, -1, compute_errors(ref, got), lfm_err,
+            note, "65536 BAM angles, 1024-elem blocks"};
+}
+
+/* Scalar reference loops, so the table shows the per-element cost of
+ * calling fr_*_bam one sample at a time. */
+static void sin_bam_loop(const u16 *b, s32 *o, u32 n) { for (u32 i = 0; i < n; i++) o[i] = fr_sin_bam(b[i]); }
+static void tan_bam_loop(const u16 *b, s32 *o, u32 n) { for (u32 i = 0; i < n; i++) o[i] = fr_tan_bam(b[i]); }
+
+static void bench_bam_arrays(std::vector<BenchResult>& results) {
+    results.push_back(bench_bam_array("sin_bam loop", "std::sin", sin_bam_loop, std::sin,
+                                      "FR_math only; ns/element, scalar fr_sin_bam per sample"));
+    results.push_back(bench_bam_array("tan_bam loop", "std::tan", tan_bam_loop, std::tan,
+                                      "FR_math only; ns/element, scalar fr_tan_bam per sample"));
+#ifdef FR_SIMD_X86
+    static const char *lvl_name[] = { "portable", "sse4.1", "avx2" };
+    int top = fr_simd_x86_level();
+    for (int lvl = FR_SIMD_NONE; lvl <= top; lvl++) {
+        fr_simd_x86_limit(lvl);
+        std::string note = std::string("FR_math only; ns/element, FR_SIMD_X86 ") + lvl_name[lvl];
+        results.push_back(bench_bam_array((std::string("sin[] ") + lvl_name[lvl]).c_str(),
+                                          "std::sin", fr_sin_bam_array, std::sin, note.c_str()));
+        results.push_back(bench_bam_array((std::string("cos[] ") + lvl_name[lvl]).c_str(),
+                                          "std::cos", fr_cos_bam_array, std::cos, note.c_str()));
+        results.push_back(bench_bam_array((std::string("tan[] ") + lvl_name[lvl]).c_str(),
+                                          "std::tan", fr_tan_bam_array, std::tan, note.c_str()));
+    }
+    fr_simd_x86_limit(FR_SIMD_AVX2);
+#else
+    results.push_back(bench_bam_array("sin[]", "std::sin", fr_sin_bam_array, std::sin,
+                                      "FR_math only; ns/element, portable loop"));
+    results.push_back(bench_bam_array("cos[]", "std::cos", fr_cos_bam_array, std::cos,
+                                      "FR_math only; ns/element, portable loop"));
+    results.push_back(bench_bam_array("tan[]", "std::tan", fr_tan_bam_array, std::tan,
+                                      "FR_math only; ns/element, portable loop"));
+#endif
+}
+
+/* --- exp / log arrays: ns per element over a Q16.16 input set --- */
+
+typedef void (*q16_array_fn)(const s32 *, s32 *, u32);
+
+static BenchResult bench_q16_array(const char *name, const char *gold,
+                                   q16_array_fn fn, double (*ref_fn)(double),
+                                   const std::vector<int32_t>& inputs,
+                                   const char *note, const char *sweep) {
+    int n = (int)inputs.size();
+    std::vector<int32_t> out(n);
+    fn(inputs.data(), out.data(), (u32)n);
+
+    std::vector<double> ref(n);
+    for (int i = 0; i < n; i++) ref[i] = ref_fn(q16_to_dbl(inputs[i]));
+
+    int blk = 1024;
+    int off = 0;
+    double fr_ns = time_block_fn([&]{
+        fn(inputs.data() + off, out.data() + off, (u32)blk);
+        sink = out[off];
+        off = (off + blk) % (n - blk);
+    }, blk);
+
+    ErrorStats lfm_err = {};
+    return {name, gold, fr_ns, -1, compute_errors(ref, out), lfm_err, note, sweep};
+}
+
+static void exp_loop(const s32 *x, s32 *o, u32 n)  { for (u32 i = 0; i < n; i++) o[i] = FR_EXP(x[i], RADIX); }
+static void ln_loop(const s32 *x, s32 *o, u32 n)   { for (u32 i = 0; i < n; i++) o[i] = FR_ln(x[i], RADIX, RADIX); }
+static void exp_arr(const s32 *x, s32 *o, u32 n)   { FR_exp_array(x, o, n, RADIX); }
+static void pow2_arr(const s32 *x, s32 *o, u32 n)  { FR_pow2_array(x, o, n, RADIX); }
+static void ln_arr(const s32 *x, s32 *o, u32 n)    { FR_ln_array(x, o, n, RADIX, RADIX); }
+static void log2_arr(const s32 *x, s32 *o, u32 n)  { FR_log2_array(x, o, n, RADIX, RADIX); }
+
+static void bench_explog_arrays(std::vector<BenchResult>& results) {
+    auto ex = make_exp_inputs(N_ACCURACY);
+    auto lg = make_pos_inputs(N_ACCURACY);
+    const char *xs = "65536-pt, [-5, 5], 1024-elem blocks";
+    const char *ls = "65536-pt, [0.01, 100], 1024-elem blocks";
+
+    results.push_back(bench_q16_array("exp loop", "std::exp", exp_loop, std::exp, ex,
+                                      "FR_math only; ns/element, scalar FR_EXP per sample", xs));
+    results.push_back(bench_q16_array("ln loop", "std::log", ln_loop, std::log, lg,
+                                      "FR_math only; ns/element, scalar FR_ln per sample", ls));
+#ifdef FR_SIMD_X86
+    static const char *lvl_name[] = { "portable", "sse4.1", "avx2" };
+    int top = fr_simd_x86_level();
+    for (int lvl = FR_SIMD_NONE; lvl <= top; lvl += FR_SIMD_AVX2) {  /* no SSE4.1 kernel */
+        fr_simd_x86_limit(lvl);
+        std::string note = std::string("FR_math only; ns/element, FR_SIMD_X86 ") + lvl_name[lvl];
+        std::string sfx = std::string(" ") + lvl_name[lvl];
+        results.push_back(bench_q16_array(("pow2[]" + sfx).c_str(), "std::exp2", pow2_arr, std::exp2, ex, note.c_str(), xs));
+        results.push_back(bench_q16_array(("exp[]" + sfx).c_str(), "std::exp", exp_arr, std::exp, ex, note.c_str(), xs));
+        results.push_back(bench_q16_array(("log2[]" + sfx).c_str(), "std::log2", log2_arr, std::log2, lg, note.c_str(), ls));
+        results.push_back(bench_q16_array(("ln[]" + sfx).c_str(), "std::log", ln_arr, std::log, lg, note.c_str(), ls));
+    }
+    fr_simd_x86_limit(FR_SIMD_AVX2);
+#else
+    const char *note = "FR_math only; ns/element, portable loop";
+    results.push_back(bench_q16_array("pow2[]", "std::exp2", pow2_arr, std::exp2, ex, note, xs));
+    results.push_back(bench_q16_array("exp[]", "std::exp", exp_arr, std::exp, ex, note, xs));
+    results.push_back(bench_q16_array("log2[]", "std::log2", log2_arr, std::log2, lg, note, ls));
+    results.push_back(bench_q16_array("ln[]", "std::log", ln_arr, std::log, lg, note, ls));
+#endif
+}
+
+/* --- dot product / GEMM: fr_dot / fr_gemm vs hand-rolled FR_FixMuls loops --- */
+
+/* The loop most callers write: every product rounded, then summed */
+static s32 dot_fixmuls(const s32 *a, const s32 *b, int n) {
+    s32 s = 0;
+    for (int i = 0; i < n; i++) s += FR_FixMuls(a[i], b[i]);
+    return s;
+}
+
+static void gemm_fixmuls(const s32 *A, const s32 *B, s32 *C, int m, int k, int n) {
+    for (int i = 0; i < m; i++)
+        for (int j = 0; j < n; j++) {
+            s32 s = 0;
+            for (int kk = 0; kk < k; kk++) s += FR_FixMuls(A[i * k + kk], B[kk * n + j]);
+            C[i * n + j] = s;
+        }
+}
+
+/* Dot rows: 1024 dot products of length 64 over [-1, 1] (ns per
+ * multiply-add). GEMM rows: 64 x 64 x 64 (ns per multiply-add). Errors
+ * are against the double-precision result. */
+static void bench_dot_gemm(std::vector<BenchResult>& results) {
+    const int L = 64, NV = 1024, G = 64;
+    auto u = make_unit_inputs(L * NV + L);
+    std::vector<double> ref(NV), gref(G * G);
+    std::vector<int32_t> out(NV), gout(G * G);
+    ErrorStats lfm_err = {};
+
+    for (int v = 0; v < NV; v++) {
+        double s = 0;
+        for (int i = 0; i < L; i++) s += q16_to_dbl(u[v * L + i]) * q16_to_dbl(u[(v * 7 + i * 13) % (L * NV)]);
+        ref[v] = s;
+    }
+    std::vector<int32_t> bv(L * NV);
+    for (int i = 0; i < L * NV; i++) bv[i] = u[(i / L * 7 + i % L * 13) % (L * NV)];
+
+    const char *dsweep = "1024 x 64-elem, [-1, 1]";
+    for (int v = 0; v < NV; v++) out[v] = dot_fixmuls(&u[v * L], &bv[v * L], L);
+    int ti = 0;
+    double ns = time_block_fn([&]{ sink = dot_fixmuls(&u[ti * L], &bv[ti * L], L); ti = (ti + 1) % NV; }, L);
+    results.push_back({"dot loop", "double", ns, -1, compute_errors(ref, out), lfm_err,
+                       "FR_math only; ns/MAC, FR_FixMuls per term", dsweep});
+
+    for (int i = 0; i < G; i++)
+        for (int j = 0; j < G; j++) {
+            double s = 0;
+            for (int kk = 0; kk < G; kk++) s += q16_to_dbl(u[i * G + kk]) * q16_to_dbl(bv[kk * G + j]);
+            gref[i * G + j] = s;
+        }
+    const char *gsweep = "64 x 64 x 64, [-1, 1]";
+    gemm_fixmuls(u.data(), bv.data(), gout.data(), G, G, G);
+    ns = time_block_fn([&]{ gemm_fixmuls(u.data(), bv.data(), gout.data(), G, G, G); sink = gout[0]; }, G * G * G);
+    results.push_back({"gemm loop", "double", ns, -1, compute_errors(gref, gout), lfm_err,
+                       "FR_math only; ns/MAC, FR_FixMuls per term", gsweep});
+
+#ifdef FR_SIMD_X86
+    static const char *lvl_name[] = { "portable", "sse4.1", "avx2" };
+    int top = fr_simd_x86_level();
+    for (int lvl = FR_SIMD_NONE; lvl <= top; lvl += FR_SIMD_AVX2) {  /* no SSE4.1 kernel */
+        fr_simd_x86_limit(lvl);
+        std::string note = std::string("FR_math only; ns/MAC, FR_SIMD_X86 ") + lvl_name[lvl];
+        std::string sfx = std::string(" ") + lvl_name[lvl];
+#else
+    {
+        std::string note = "FR_math only; ns/MAC, portable loop";
+        std::string sfx;
+#endif
+        for (int v = 0; v < NV; v++) out[v] = fr_dot(&u[v * L], &bv[v * L], L, RADIX);
+        ti = 0;
+        ns = time_block_fn([&]{ sink = fr_dot(&u[ti * L], &bv[ti * L], L, RADIX); ti = (ti + 1) % NV; }, L);
+        results.push_back({"dot" + sfx, "double", ns, -1, compute_errors(ref, out), lfm_err, note, dsweep});
+
+        fr_gemm(u.data(), bv.data(), gout.data(), G, G, G, RADIX);
+        ns = time_block_fn([&]{ fr_gemm(u.data(), bv.data(), gout.data(), G, G, G, RADIX); sink = gout[0]; }, G * G * G);
+        results.push_back({"gemm" + sfx, "double", ns, -1, compute_errors(gref, gout), lfm_err, note, gsweep});
+    }
+#ifdef FR_SIMD_X86
+    fr_simd_x86_limit(FR_SIMD_AVX2);
+#endif
+}
+
+/* Biquad cascade throughput: 4 sections, mono and 8 interleaved channels.
+ * Reference is the same quantised coefficients run in double, so the
+ * error column is the fixed-point arithmetic alone. ns per channel-sample;
+ * the note gives samples per second on one core. */
+static void bq_double(const fr_bq_coef_t *c, int nsec, const int32_t *in, std::vector<double>& out,
+                      int frames, int nch) {
+    for (int ch = 0; ch < nch; ch++) {
+        for (int f = 0; f < frames; f++) out[f * nch + ch] = q16_to_dbl(in[f * nch + ch]);
+        for (int s = 0; s < nsec; s++) {
+            double k = 1.0 / (1 << FR_BQ_RADIX), x1 = 0, x2 = 0, y1 = 0, y2 = 0;
+            for (int f = 0; f < frames; f++) {
+                double x = out[f * nch + ch];
+                double y = k * (c[s].b0 * x + c[s].b1 * x1 + c[s].b2 * x2 - c[s].a1 * y1 - c[s].a2 * y2);
+                x2 = x1; x1 = x; y2 = y1; y1 = y;
+                out[f * nch + ch] = y;
+            }
+        }
+    }
+}
+
+static void bench_biquad(std::vector<BenchResult>& results) {
+    const int F = 4096, NS = 4;
+    fr_bq_coef_t c[NS];
+    fr_biquad_design(&c[0], FR_BQ_HIGHPASS, 40, 48000, FR_NUM(0, 7071, 4, 16), 0);
+    fr_biquad_design(&c[1], FR_BQ_PEAK, 1000, 48000, 2 << 16, 6 << 16);
+    fr_biquad_design(&c[2], FR_BQ_PEAK, 5000, 48000, 1 << 16, -(4 << 16));
+    fr_biquad_design(&c[3], FR_BQ_LOWPASS, 12000, 48000, FR_NUM(0, 7071, 4, 16), 0);
+    ErrorStats lfm_err = {};
+    char buf[160];
+#ifdef FR_SIMD_X86
+    static const char *lvl_name[] = { "portable", "sse4.1", "avx2" };
+    int avail = fr_simd_x86_level();
+#endif
+
+    for (int nch = 1; nch <= 8; nch += 7) {
+        auto in = make_unit_inputs(F * nch);
+        std::vector<double> ref(F * nch);
+        std::vector<int32_t> out(F * nch), st(FR_BQ_STATE * NS * nch);
+        fr_biquad_t bq;
+        bq_double(c, NS, in.data(), ref, F, nch);
+        std::string sweep = std::to_string(F) + " frames x " + std::to_string(nch) + " ch, [-1, 1]";
+#ifdef FR_SIMD_X86
+        int top = (nch >= 4) ? avail : FR_SIMD_NONE;
+        for (int lvl = FR_SIMD_NONE; lvl <= top; lvl += FR_SIMD_AVX2) {  /* no SSE4.1 kernel */
+            fr_simd_x86_limit(lvl);
+            std::string mode = std::string("FR_SIMD_X86 ") + lvl_name[lvl];
+            std::string sfx = (nch >= 4) ? std::string(" ") + lvl_name[lvl] : std::string();
+#else
+        {
+            std::string mode = "portable loop";
+            std::string sfx;
+#endif
+            fr_biquad_init(&bq, c, NS, (u32)nch, st.data());
+            double ns = time_block_fn([&]{ fr_biquad_process(&bq, in.data(), out.data(), F); sink = out[0]; },
+                                      F * nch);
+            fr_biquad_reset(&bq);
+            fr_biquad_process(&bq, in.data(), out.data(), F);
+            snprintf(buf, sizeof buf, "FR_math only; ns/sample, %.0f Msample/s/core, %s", 1e3 / ns, mode.c_str());
+            results.push_back({std::string("biquad x4 ") + (nch > 1 ? "8ch" : "mono") + sfx, "double",
+                               ns, -1, compute_errors(ref, out), lfm_err, buf, sweep});
+        }
+    }
+#ifdef FR_SIMD_X86
+    fr_simd_x86_limit(FR_SIMD_AVX2);
+#endif
+}
+
+/* FFT vs a naive O(n^2) fixed-point DFT, 1024 complex points of unit
+ * noise. Timing is ns per point (one transform = 1024 points) and
+ * includes restoring the input; the note gives the SNR against a double
+ * DFT. Output LSBs are those of each result at its block exponent. */
+static void dft_naive(const int32_t *x, int32_t *y, int n) {
+    for (int k = 0; k < n; k++) {
+        int64_t re = 0, im = 0;
+        for (int j = 0; j < n; j++) {
+            u16 bam = (u16)(((uint32_t)(j * k) % (uint32_t)n) * (65536u / (uint32_t)n));
+            int64_t c = fr_cos_bam(bam), s = fr_sin_bam(bam);
+            re += x[2 * j] * c + x[2 * j + 1] * s;      /* x * e^(-i theta) */
+            im += x[2 * j + 1] * c - x[2 * j] * s;
+        }
+        y[2 * k] = (int32_t)((re + 32768) >> 16);
+        y[2 * k + 1] = (int32_t)((im + 32768) >> 16);
+    }
+}
+
+static double snr_db(const std::vector<double>& ref, const std::vector<int32_t>& got, int e) {
+    double s = 0, d = 0;
+    for (size_t i = 0; i < ref.size(); i++) {
+        double g = std::ldexp((double)got[i], e);
+        s += ref[i] * ref[i];
+        d += (ref[i] - g) * (ref[i] - g);
+    }
+    return 10 * std::log10(s / (d + 1e-300));
+}
+
+static void bench_fft(std::vector<BenchResult>& results) {
+    const int N = 1024;
+    auto in = make_unit_inputs(2 * N);
+    std::vector<double> ref(2 * N), rref(N + 2);
+    std::vector<int32_t> out(2 * N), work(2 * N), tw(FR_FFT_TW_LEN(N));
+    std::vector<int16_t> in16(2 * N), x16(2 * N), w16(2 * N);
+    ErrorStats lfm_err = {};
+    const char *sweep = "1024-pt complex, [-1, 1]";
+    char note[160];
+    fr_fft_t f;
+    fr_fft_init(&f, N, tw.data());
+
+    for (int k = 0; k < N; k++) {
+        double re = 0, im = 0;
+        for (int j = 0; j < N; j++) {
+            double a = -2 * M_PI * (double)((j * k) % N) / N;
+            double xr = in[2 * j], xi = in[2 * j + 1];
+            re += xr * std::cos(a) - xi * std::sin(a);
+            im += xr * std::sin(a) + xi * std::cos(a);
+        }
+        ref[2 * k] = re; ref[2 * k + 1] = im;        /* raw units of in */
+    }
+    for (int k = 0; k <= N / 2; k++) {               /* real part of in as a real signal */
+        double re = 0, im = 0;
+        for (int j = 0; j < N; j++) {
+            double a = -2 * M_PI * (double)((j * k) % N) / N;
+            re += in[j] * std::cos(a);
+            im += in[j] * std::sin(a);
+        }
+        rref[2 * k] = re; rref[2 * k + 1] = im;
+    }
+    /* compute_errors compares q16_to_dbl(out) with ref: put ref in the
+     * output's units (divide by 2^e) and back into Q16 */
+    auto scaled = [](const std::vector<double>& r, int e) {
+        std::vector<double> v(r.size());
+        for (size_t i = 0; i < r.size(); i++) v[i] = std::ldexp(r[i], -e) / ONE;
+        return v;
+    };
+
+    dft_naive(in.data(), out.data(), N);
+    double ns = time_block_fn([&]{ dft_naive(in.data(), out.data(), N); sink = out[0]; }, N);
+    snprintf(note, sizeof note, "FR_math only; ns/point, fr_cos_bam/fr_sin_bam, SNR %.1f dB", snr_db(ref, out, 0));
+    results.push_back({"dft naive", "double", ns, -1, compute_errors(scaled(ref, 0), out), lfm_err, note, sweep});
+
+    int e = 0;
+    ns = time_block_fn([&]{ std::copy(in.begin(), in.end(), out.begin()); e = fr_fft(&f, out.data(), work.data()); sink = out[0]; }, N);
+    snprintf(note, sizeof note, "FR_math only; ns/point, radix-4 Stockham, SNR %.1f dB", snr_db(ref, out, e));
+    results.push_back({"fft", "double", ns, -1, compute_errors(scaled(ref, e), out), lfm_err, note, sweep});
+
+    for (int i = 0; i < 2 * N; i++) in16[i] = (int16_t)(in[i] >> 1);   /* Q15 */
+    std::vector<double> ref15(2 * N);
+    for (int i = 0; i < 2 * N; i++) ref15[i] = ref[i] / 2;
+    ns = time_block_fn([&]{ x16 = in16; e = fr_fft16(&f, x16.data(), w16.data()); sink = x16[0]; }, N);
+    std::vector<int32_t> o16(x16.begin(), x16.end());
+    snprintf(note, sizeof note, "FR_math only; ns/point, s16 data, SNR %.1f dB", snr_db(ref15, o16, e));
+    results.push_back({"fft16", "double", ns, -1, compute_errors(scaled(ref15, e), o16), lfm_err, note, sweep});
+
+    ns = time_block_fn([&]{ std::copy(in.begin(), in.begin() + N, out.begin()); e = fr_rfft(&f, out.data(), work.data()); sink = out[0]; }, N);
+    std::vector<int32_t> ro(N + 2);
+    ro[0] = out[0]; ro[1] = 0; ro[N] = out[1]; ro[N + 1] = 0;
+    for (int i = 2; i < N; i++) ro[i] = out[i];
+    snprintf(note, sizeof note, "FR_math only; ns/point, 1024 real in, SNR %.1f dB", snr_db(rref, ro, e));
+    results.push_back({"rfft", "double", ns, -1, compute_errors(scaled(rref, e), ro), lfm_err, note,
+                       "1024-pt real, [-1, 1]"});
+}
+
+/* Tone banks: the 8 DTMF tones on 256 channels at 8 kHz, n = 205.
+ * ns per channel-sample (all 8 tones); the error column is the last
+ * window's magnitudes against a double DFT at the frequency each bank
+ * is centred on. */
+static double tone_mag_ref(const std::vector<int16_t>& x, int nch, int ch, int m0, int n, double w) {
+    double re = 0, im = 0;
+    for (int m = 0; m < n; m++) {
+        re += x[(m0 + m) * nch + ch] * std::cos(w * m);
+        im -= x[(m0 + m) * nch + ch] * std::sin(w * m);
+    }
+    return std::sqrt(re * re + im * im);
+}
+
+static void bench_tone(std::vector<BenchResult>& results) {
+    const int NCH = 256, NT = 8, N = 205, F = 10 * N;
+    static const int hz[NT] = { 697, 770, 852, 941, 1209, 1336, 1477, 1633 };
+    u16 bam[NT];
+    for (int t = 0; t < NT; t++) bam[t] = FR_HZ2BAM_INC(hz[t], 8000);
+    auto u = make_unit_inputs(F * NCH);
+    std::vector<int16_t> in(F * NCH), hist(N * NCH);
+    for (int i = 0; i < F * NCH; i++) in[i] = (int16_t)(u[i] >> 1);
+    std::vector<int32_t> st(FR_GOERTZEL_STATE(NT, NCH)), mag(NT * NCH);
+    std::vector<int64_t> acc(FR_SDFT_ACC(NT, NCH));
+    std::vector<double> gref(NT * NCH), sref(NT * NCH);
+    for (int t = 0; t < NT; t++)
+        for (int ch = 0; ch < NCH; ch++) {
+            gref[t * NCH + ch] = tone_mag_ref(in, NCH, ch, F - N, N, std::acos(fr_cos_bam(bam[t]) / 65536.0)) / ONE;
+            sref[t * NCH + ch] = tone_mag_ref(in, NCH, ch, F - N, N, 2 * M_PI * bam[t] / 65536.0) / ONE;
+        }
+    ErrorStats lfm_err = {};
+    const char *sweep = "8 DTMF tones x 256 ch, n = 205, [-1, 1] as s16";
+    char note[160];
+    fr_goertzel_t g;
+    fr_sdft_t sd;
+#ifdef FR_SIMD_X86
+    static const char *lvl_name[] = { "portable", "sse4.1", "avx2" };
+    int avail = fr_simd_x86_level();
+    for (int lvl = FR_SIMD_NONE; lvl <= avail; lvl += FR_SIMD_AVX2) {  /* no SSE4.1 kernel */
+        fr_simd_x86_limit(lvl);
+        std::string mode = std::string("FR_SIMD_X86 ") + lvl_name[lvl];
+        std::string sfx = std::string(" ") + lvl_name[lvl];
+#else
+    {
+        std::string mode = "portable loop";
+        std::string sfx;
+#endif
+        fr_goertzel_init(&g, bam, NT, NCH, N, st.data());
+        double ns = time_block_fn([&]{ fr_goertzel_process(&g, in.data(), F, mag.data()); sink = mag[0]; }, F * NCH);
+        snprintf(note, sizeof note, "FR_math only; ns/ch-sample, %.0f Msample/s/core, %s", 1e3 / ns, mode.c_str());
+        results.push_back({"goertzel x8" + sfx, "double", ns, -1, compute_errors(gref, mag), lfm_err, note, sweep});
+
+        fr_sdft_init(&sd, bam, NT, NCH, N, acc.data(), hist.data());
+        ns = time_block_fn([&]{ fr_sdft_process(&sd, in.data(), F); sink = (int32_t)acc[0]; }, F * NCH);
+        fr_sdft_mag(&sd, mag.data());
+        snprintf(note, sizeof note, "FR_math only; ns/ch-sample, bins every frame, %.0f Msample/s/core, %s",
+                 1e3 / ns, mode.c_str());
+        results.push_back({"sdft x8" + sfx, "double", ns, -1, compute_errors(sref, mag), lfm_err, note, sweep});
+    }
+#ifdef FR_SIMD_X86
+    fr_simd_x86_limit(FR_SIMD_AVX2);
+#endif
+}
+
 /* ================================================================
  * JSON output
  * ================================================================ */
@@ -814,6 +1327,7 @@ int main() {
     results.push_back(bench_acos());  fprintf(stderr, "  acos done\n");
     results.push_back(bench_atan());  fprintf(stderr, "  atan done\n");
     results.push_back(bench_atan2()); fprintf(stderr, "  atan2 done\n");
+    results.push_back(bench_atan2_iq()); fprintf(stderr, "  atan2 (IQ) done\n");
     results.push_back(bench_sqrt());  fprintf(stderr, "  sqrt done\n");
     results.push_back(bench_exp());   fprintf(stderr, "  exp done\n");
     results.push_back(bench_log());   fprintf(stderr, "  ln done\n");
@@ -822,6 +1336,12 @@ int main() {
     results.push_back(bench_div());   fprintf(stderr, "  div done\n");
     results.push_back(bench_hypot()); fprintf(stderr, "  hypot done\n");
     results.push_back(bench_hypot_fast8()); fprintf(stderr, "  hypot_fast8 done\n");
+    bench_bam_arrays(results);        fprintf(stderr, "  bam arrays done\n");
+    bench_explog_arrays(results);     fprintf(stderr, "  exp/log arrays done\n");
+    bench_dot_gemm(results);          fprintf(stderr, "  dot/gemm done\n");
+    bench_biquad(results);            fprintf(stderr, "  biquad done\n");
+    bench_fft(results);               fprintf(stderr, "  fft done\n");
+    bench_tone(results);              fprintf(stderr, "  tone done\n");
 
     emit_json(stdout, results);
     emit_markdown(stderr, results);
@@ -2,7 +2,9 @@
  * trig_accuracy.cpp — FR_math vs libfixmath vs IEEE double trig comparison
  *
  * Sweeps 0-360 degrees in 1-degree steps for sin, cos, tan.
- * Prints a per-degree detail table and a summary table.
+ * Prints a per-degree detail table and a summary table, then compares
+ * the s15.16 BAM path (fr_sin_bam) with the s1.30 path (fr_sin_bam32)
+ * for max error and throughput.
  *
  * Requires libfixmath source at compare_lfm/libfixmath/libfixmath/.
  * Build:  make ex_trig_accuracy   (only built if libfixmath is present)
@@ -12,6 +14,7 @@
  */
 
 #include <stdio.h>
+#include <time.h>
 #include <cmath>
 
 #include "FR_defs.h"
@@ -41,6 +44,52 @@ static void err_add(err_stats_t *e, double pct)
     e->n++;
 }
 
+/* ------------------------------------------------------------------
+ * s15.16 vs s1.30 sine: max / mean absolute error over a dense phase
+ * sweep, and ns per call.
+ * ------------------------------------------------------------------ */
+static volatile s32 g_sink;
+
+static double ns_per_call(s32 (*fn)(u32), u32 step)
+{
+    const int n = 1 << 22;
+    u32 p = 0;
+    clock_t t0 = clock();
+    for (int i = 0; i < n; i++) { g_sink = fn(p); p += step; }
+    return (double)(clock() - t0) * 1e9 / CLOCKS_PER_SEC / n;
+}
+
+static s32 sin16_of_phase(u32 p) { return fr_sin_bam((u16)(p >> 16)); }
+static s32 sin32_of_phase(u32 p) { return fr_sin_bam32(p); }
+
+static void precision_compare(void)
+{
+    const u32 step = 2654435761u >> 10;        /* ~2.6M phases per turn */
+    double max16 = 0, sum16 = 0, max32 = 0, sum32 = 0;
+    int n = 0;
+
+    for (u32 p = 0, k = 0; k < (1u << 22); k++, p += step) {
+        double ref = sin((double)(p & 0xffff0000u) * (2.0 * M_PI / 4294967296.0));
+        double ref32 = sin((double)p * (2.0 * M_PI / 4294967296.0));
+        double e16 = fabs(fr_sin_bam((u16)(p >> 16)) / 65536.0 - ref);
+        double e32 = fabs(fr_sin_bam32(p) / 1073741824.0 - ref32);
+        if (e16 > max16) max16 = e16;
+        if (e32 > max32) max32 = e32;
+        sum16 += e16; sum32 += e32; n++;
+    }
+
+    printf("\n  ============================================================\n");
+    printf("  Precision: fr_sin_bam (s15.16) vs fr_sin_bam32 (s1.30)\n");
+    printf("  ============================================================\n\n");
+    printf("  %-14s | %12s %12s %10s | %8s\n", "function", "max_abs", "avg_abs", "max_LSB", "ns/call");
+    printf("  %-14s-+-%12s-%12s-%10s-+-%8s\n", "--------------", "------------", "------------", "----------", "--------");
+    printf("  %-14s | %12.3e %12.3e %10.2f | %8.2f\n", "fr_sin_bam",
+           max16, sum16 / n, max16 * 65536.0, ns_per_call(sin16_of_phase, step));
+    printf("  %-14s | %12.3e %12.3e %10.2f | %8.2f\n", "fr_sin_bam32",
+           max32, sum32 / n, max32 * 1073741824.0, ns_per_call(sin32_of_phase, step));
+    printf("\n  max_LSB is in each function's own output unit (2^-16 vs 2^-30).\n");
+}
+
 /* ================================================================== */
 int main()
 {
@@ -134,6 +183,8 @@ int main()
     printf("  libfixmath: fix16_sin/cos/tan         (fix16_t radians, Q16.16 output)\n");
     printf("  Reference:  IEEE 754 double sin/cos/tan\n");
 
+    precision_compare();
+
     printf("\n--- end ---\n");
     return 0;
 }
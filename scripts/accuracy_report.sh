@@ -6,6 +6,7 @@
 # Usage:
 #   scripts/accuracy_report.sh            # build, run, print table to stdout
 #   scripts/accuracy_report.sh --update   # also patch the three doc files
+#   scripts/accuracy_report.sh --tables   # one table per lookup-table size
 #
 # The table is delimited by sentinel comments:
 #   <!-- ACCURACY_TABLE_START -->
@@ -26,17 +27,46 @@ for arg in "$@"; do
     case "$arg" in
         --update) MODE="update" ;;
         --showpeak) SHOWPEAK="1" ;;
+        --tables) MODE="tables" ;;
         -h|--help)
-            echo "Usage: scripts/accuracy_report.sh [--update] [--showpeak]"
+            echo "Usage: scripts/accuracy_report.sh [--update] [--showpeak] [--tables]"
             echo "  (no args)   Build test_tdd, run it, print accuracy table"
             echo "  --update    Also patch README.md, docs/README.md, pages/index.html"
             echo "  --showpeak  Add a 'Peak at' column showing the input that produced max % error"
+            echo "  --tables    Print one table per supported FR_TRIG_TABLE_BITS /"
+            echo "              FR_LOG_TABLE_BITS size (docs are not patched)"
             exit 0
             ;;
         *) echo "Unknown option: $arg" >&2; exit 1 ;;
     esac
 done
 
+# -----------------------------------------------------------------------
+# 0. --tables: rebuild test_tdd at each supported lookup-table size.
+#    Trig and log sizes are stepped together, from smallest to largest.
+# -----------------------------------------------------------------------
+if [ "$MODE" = "tables" ]; then
+    make -s dirs
+    for pair in "6 5" "7 6" "8 7" "9 8"; do
+        set -- $pair
+        DEFS="-DFR_TRIG_TABLE_BITS=$1 -DFR_LOG_TABLE_BITS=$2"
+        echo "Building test_tdd ($DEFS)..." >&2
+        make -s -B build/test_tdd TABLE_DEFS="$DEFS" 2>&1 >&2
+        echo ""
+        echo "### FR_TRIG_TABLE_BITS=$1 ($(( (1 << $1) + 1 ))-entry sine table)," \
+             "FR_LOG_TABLE_BITS=$2 ($(( (1 << $2) + 1 ))-entry log/exp tables)"
+        echo ""
+        if [ -n "$SHOWPEAK" ]; then
+            FR_SHOWPEAK=1 ./build/test_tdd 2>/dev/null | sed -n '/<!-- ACCURACY_TABLE_START -->/,/<!-- ACCURACY_TABLE_END -->/p'
+        else
+            ./build/test_tdd 2>/dev/null | sed -n '/<!-- ACCURACY_TABLE_START -->/,/<!-- ACCURACY_TABLE_END -->/p'
+        fi
+    done
+    # leave the default-size binary behind for the other targets
+    make -s -B build/test_tdd 2>&1 >&2
+    exit 0
+fi
+
 # -----------------------------------------------------------------------
 # 1. Build test_tdd
 # -----------------------------------------------------------------------
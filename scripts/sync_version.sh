@@ -21,6 +21,8 @@
 #   pages/version.json           — {"version":"X.Y.Z","hex":"0xMMmmpp"} for site.js
 #   src/FR_math_2D.h             — @version doxygen tag
 #   src/FR_math_2D.cpp           — @version doxygen tag
+#   src/FR_math_3D.h / .cpp      — @version doxygen tag
+#   src/FR_math_quat.h / .cpp    — @version doxygen tag
 #   library.properties           — Arduino Library Manager version
 #   library.json                 — PlatformIO registry version
 #   idf_component.yml            — ESP-IDF Component Registry version
@@ -228,6 +230,22 @@ update_file "src/FR_math_2D.h @version" "${PROJECT_ROOT}/src/FR_math_2D.h" \
 update_file "src/FR_math_2D.cpp @version" "${PROJECT_ROOT}/src/FR_math_2D.cpp" \
     "s|(\\@version )[0-9]+\\.[0-9]+\\.[0-9]+|\${1}${VERSION}|g"
 
+# --------------------------------------------------------------------------
+# 7b. src/FR_math_3D.h / .cpp — @version doxygen tag
+# --------------------------------------------------------------------------
+update_file "src/FR_math_3D.h @version" "${PROJECT_ROOT}/src/FR_math_3D.h" \
+    "s|(\\@version )[0-9]+\\.[0-9]+\\.[0-9]+|\${1}${VERSION}|g"
+update_file "src/FR_math_3D.cpp @version" "${PROJECT_ROOT}/src/FR_math_3D.cpp" \
+    "s|(\\@version )[0-9]+\\.[0-9]+\\.[0-9]+|\${1}${VERSION}|g"
+
+# --------------------------------------------------------------------------
+# 7c. src/FR_math_quat.h / .cpp — @version doxygen tag
+# --------------------------------------------------------------------------
+update_file "src/FR_math_quat.h @version" "${PROJECT_ROOT}/src/FR_math_quat.h" \
+    "s|(\\@version )[0-9]+\\.[0-9]+\\.[0-9]+|\${1}${VERSION}|g"
+update_file "src/FR_math_quat.cpp @version" "${PROJECT_ROOT}/src/FR_math_quat.cpp" \
+    "s|(\\@version )[0-9]+\\.[0-9]+\\.[0-9]+|\${1}${VERSION}|g"
+
 # --------------------------------------------------------------------------
 # 8. library.properties — version field
 #    Pattern: version=2.0.1
@@ -42,6 +42,7 @@
 
 #ifdef FR_LEAN
 #define FR_NO_WAVES
+#define FR_NO_ARRAY
 #endif
 
 #ifdef __cplusplus
@@ -251,6 +252,295 @@ static inline s32 FR_div_rnd(s64 num, s32 den) {
   s32 FR_FixMuls(s32 x, s32 y);   // mul signed, round-to-nearest, NOT saturated
   s32 FR_FixMulSat(s32 x, s32 y); // mul signed, round-to-nearest, saturated
   s32 FR_FixAddSat(s32 x, s32 y); // add signed, saturated
+  s32 FR_FixSubSat(s32 x, s32 y); // subtract signed, saturated
+
+  /* Saturating array arithmetic, i < n. Saturates to FR_OVERFLOW_POS /
+   * FR_OVERFLOW_NEG like the scalar functions (s16 forms: 32767 / -32768).
+   *
+   *   FR_FixAddSat_array(x, y, out, n, xr, yr)   out = x + y at radix xr
+   *   FR_FixSubSat_array(x, y, out, n, xr, yr)   out = x - y at radix xr
+   *   FR_FixMulSat_array(x, y, out, n, xr, yr, or)
+   *                                 out = x * y at radix or, rounded once
+   *   FR_FixScaleSat_array(x, k, out, n, kr)     out = x * k (k at radix kr),
+   *                                              at x's radix
+   *   FR_FixMacSat_array(acc, x, y, n, xr, yr, ar)
+   *                                 acc = FR_FixAddSat(acc, x * y at radix ar)
+   *   FR_FixAddSat16_array / FR_FixSubSat16_array (x, y, out, n)
+   *   FR_FixMulSat16_array(x, y, out, n, r)      s16 at radix r (0..30)
+   *
+   * y is moved to x's radix as FR_CHRDX does, but a left shift saturates.
+   * With every radix 16, FR_FixMulSat_array matches FR_FixMulSat. out may
+   * alias an input; NULL pointers are a no-op. With FR_SIMD_X86 these use
+   * AVX2 when available (bit-identical).
+   */
+#ifndef FR_NO_ARRAY
+  void FR_FixAddSat_array(const s32 *x, const s32 *y, s32 *out, u32 n, u16 x_radix, u16 y_radix);
+  void FR_FixSubSat_array(const s32 *x, const s32 *y, s32 *out, u32 n, u16 x_radix, u16 y_radix);
+  void FR_FixMulSat_array(const s32 *x, const s32 *y, s32 *out, u32 n,
+                          u16 x_radix, u16 y_radix, u16 out_radix);
+  void FR_FixScaleSat_array(const s32 *x, s32 k, s32 *out, u32 n, u16 k_radix);
+  void FR_FixMacSat_array(s32 *acc, const s32 *x, const s32 *y, u32 n,
+                          u16 x_radix, u16 y_radix, u16 acc_radix);
+  void FR_FixAddSat16_array(const s16 *x, const s16 *y, s16 *out, u32 n);
+  void FR_FixSubSat16_array(const s16 *x, const s16 *y, s16 *out, u32 n);
+  void FR_FixMulSat16_array(const s16 *x, const s16 *y, s16 *out, u32 n, u16 radix);
+#endif
+
+  /* Dot product and matrix multiply. Inputs and the s32 result are at
+   * radix r (s16 forms: s16 inputs, s32 result). Products are summed
+   * exactly in s64, then rounded to nearest and saturated once — more
+   * accurate and faster than a loop of FR_FixMuls.
+   *
+   *   fr_dot(a, b, n, r)            sum of a[i] * b[i]
+   *   fr_gemv(A, x, y, rows, cols, r)
+   *                                 y = A x, A row-major rows x cols
+   *   fr_gemm(A, B, C, m, k, n, r)  C = A B, row-major (m x k)(k x n),
+   *                                 cache-blocked; C must not alias A, B
+   *
+   * The s64 sum only wraps if it leaves s64 (n * |a*b| >= 2^63). NULL
+   * pointers are a no-op (fr_dot returns 0). With FR_SIMD_X86 these use
+   * AVX2 when available (pmaddwd for s16), bit-identical.
+   */
+#ifndef FR_NO_ARRAY
+  s32 fr_dot(const s32 *a, const s32 *b, u32 n, u16 radix);
+  s32 fr_dot16(const s16 *a, const s16 *b, u32 n, u16 radix);
+  void fr_gemv(const s32 *A, const s32 *x, s32 *y, u32 rows, u32 cols, u16 radix);
+  void fr_gemv16(const s16 *A, const s16 *x, s32 *y, u32 rows, u32 cols, u16 radix);
+  void fr_gemm(const s32 *A, const s32 *B, s32 *C, u32 m, u32 k, u32 n, u16 radix);
+#endif
+
+/*===============================================
+ * FIR filter
+ *
+ * y[n] = sum of h[k] * x[n-k], k < ntaps. Taps h are at radix `radix`;
+ * samples in and out share any radix. Each output is an exact s64 sum,
+ * rounded and saturated once (bit-identical to fr_dot over the window).
+ * Caller-allocated struct and buffers, no malloc. The delay line holds
+ * 2 * ntaps samples (each input is stored twice so the newest ntaps are
+ * always contiguous for the SIMD dot product).
+ *
+ *   static const s32 h[31] = { ... };     // e.g. from tools/fr_coef-gen
+ *   s32 dl[2 * 31];
+ *   fr_fir_t fir;
+ *   fr_fir_init(&fir, h, 31, 16, dl);
+ *   fr_fir_process(&fir, in, out, 256);   // seamless across blocks
+ *
+ *   fr_fir_decimate(f, in, out, n, M)     keeps every M-th output; returns
+ *                                         the count written. Phase carries
+ *                                         across calls.
+ *   fr_fir_interpolate(f, in, out, n, L)  n inputs -> n * L outputs
+ *                                         (polyphase, ntaps / L MACs each).
+ *                                         Design h with DC gain L.
+ *
+ * fr_fir_process may run in place; the interpolator's out must not
+ * overlap in. NULL coef or delay gives a filter that outputs 0: every
+ * form still writes (and the decimator counts) its usual outputs.
+ */
+#ifndef FR_NO_ARRAY
+typedef struct fr_fir_s {
+    const s32 *coef;  /* ntaps taps at radix; coef[0] meets the newest sample */
+    s32 *delay;       /* 2 * ntaps samples, caller-allocated */
+    u32  ntaps;
+    u32  pos;         /* newest sample is delay[pos] (and delay[pos + ntaps]) */
+    u32  phase;       /* decimator phase */
+    u16  radix;
+} fr_fir_t;
+
+  void fr_fir_init(fr_fir_t *f, const s32 *coef, u32 ntaps, u16 radix, s32 *delay);
+  void fr_fir_reset(fr_fir_t *f);
+  s32  fr_fir_step(fr_fir_t *f, s32 x);
+  void fr_fir_process(fr_fir_t *f, const s32 *in, s32 *out, u32 n);
+  u32  fr_fir_decimate(fr_fir_t *f, const s32 *in, s32 *out, u32 n, u32 factor);
+  void fr_fir_interpolate(fr_fir_t *f, const s32 *in, s32 *out, u32 n, u32 factor);
+#endif
+
+/*===============================================
+ * Biquad IIR cascade
+ *
+ * Direct form I with second-order error feedback, per section:
+ *   acc = b0*x + b1*x1 + b2*x2 - a1*y1 - a2*y2 + 2*e1 - e2
+ *   y   = acc >> FR_BQ_RADIX (saturated),  e = the bits shifted out
+ * Coefficients are s3.28 (|c| < 8) with a0 normalised to 1. Feeding the
+ * truncation residues back cancels the noise gain of poles near DC, so
+ * low-frequency and high-Q sections stay within ~1 LSB of exact
+ * arithmetic (plain rounding drifts by hundreds of LSB at fs / 1000).
+ * Samples keep their caller radix; |x| < 2^28 never wraps the s64 sum.
+ *
+ * One coefficient set is shared by nch channels, each with its own state
+ * (FR_BQ_STATE words per section per channel). Samples are interleaved:
+ * in[frame * nch + ch]. Caller-allocated struct and buffers, no malloc.
+ *
+ *   fr_bq_coef_t c[2];
+ *   s32 st[FR_BQ_STATE * 2 * 8];
+ *   fr_biquad_t bq;
+ *   fr_biquad_design(&c[0], FR_BQ_LOWPASS, 1000, 48000, FR_NUM(0, 7071, 4, 16), 0);
+ *   fr_biquad_design(&c[1], FR_BQ_PEAK, 3000, 48000, 2 << 16, -6 << 16);
+ *   fr_biquad_init(&bq, c, 2, 8, st);
+ *   fr_biquad_process(&bq, in, out, 256);   // 256 frames x 8 channels
+ *
+ * fr_biquad_design fills one section from the RBJ audio-EQ cookbook:
+ * f0_hz and fs_hz in Hz (f0 < fs / 2), q and gain_db s15.16. q is clamped
+ * to at least 1/16 and gain_db (PEAK and the shelves) to +/-18 dB. The
+ * angle comes from fr_sincos_bam32 on FR_HZ2PHASE_INC, so the design is
+ * good to about 2^-26 even at low f0. FR_BQ_DCBLOCK is a first-order
+ * highpass with its corner at f0. Returns 1 when the section is designed.
+ * Bad arguments, or a coefficient that does not fit s3.28 (|c| >= 8),
+ * give a pass-through section (b0 = 1) and return 0. Only shelf boosts
+ * above +12 dB can hit the limit: at +18 dB a high shelf below about
+ * 0.01..0.15 fs or a low shelf above about 0.35..0.49 fs, depending on q.
+ * PEAK, cuts and shelf boosts up to +12 dB always fit.
+ *
+ * fr_biquad_process may run in place. With FR_SIMD_X86 and nch >= 4 it
+ * runs 4 channels per AVX2 register when available, bit-identical.
+ */
+#ifndef FR_NO_ARRAY
+#define FR_BQ_RADIX     (28)
+#define FR_BQ_STATE     (6)     /* x1, x2, y1, y2, e1, e2 */
+
+#define FR_BQ_LOWPASS   (0)
+#define FR_BQ_HIGHPASS  (1)
+#define FR_BQ_BANDPASS  (2)     /* 0 dB peak gain */
+#define FR_BQ_NOTCH     (3)
+#define FR_BQ_ALLPASS   (4)
+#define FR_BQ_PEAK      (5)
+#define FR_BQ_LOWSHELF  (6)
+#define FR_BQ_HIGHSHELF (7)
+#define FR_BQ_DCBLOCK   (8)
+
+typedef struct fr_bq_coef_s {
+    s32 b0, b1, b2, a1, a2;   /* s3.28, a0 = 1 */
+} fr_bq_coef_t;
+
+typedef struct fr_biquad_s {
+    const fr_bq_coef_t *coef; /* nsec sections, applied in order */
+    s32 *state;       /* FR_BQ_STATE * nsec * nch words, caller-allocated */
+    u32  nsec;
+    u32  nch;
+} fr_biquad_t;
+
+  int  fr_biquad_design(fr_bq_coef_t *c, u16 type, u32 f0_hz, u32 fs_hz, s32 q, s32 gain_db);
+  void fr_biquad_init(fr_biquad_t *bq, const fr_bq_coef_t *coef, u32 nsec, u32 nch, s32 *state);
+  void fr_biquad_reset(fr_biquad_t *bq);
+  void fr_biquad_process(fr_biquad_t *bq, const s32 *in, s32 *out, u32 frames);
+#endif
+
+/*===============================================
+ * FFT
+ *
+ * Complex data is interleaved: x[2k] = re, x[2k + 1] = im, n points.
+ * Results overwrite x in natural order (Stockham autosort, radix 4 plus
+ * one radix-2 pass for odd log2 n, no bit reversal). The caller supplies
+ * a work buffer the size of x and the twiddle table; no malloc.
+ *
+ *   s32 tw[FR_FFT_TW_LEN(1024)], x[2 * 1024], work[2 * 1024];
+ *   fr_fft_t fft;
+ *   fr_fft_init(&fft, 1024, tw);          // n a power of 2, 2 .. 2^24
+ *   e = fr_fft(&fft, x, work);            // X[k] = x_out[k] * 2^e
+ *
+ * Block floating point: before each pass the data is shifted right just
+ * enough that the pass cannot overflow, and the transforms return the
+ * total as a block exponent e: true value = output * 2^e. Inputs may use
+ * the full s32 / s16 range; small inputs are not shifted at all.
+ *
+ *   fr_fft(f, x, work)     forward, X[k] = sum x[j] e^(-2 pi i jk / n)
+ *   fr_ifft(f, x, work)    inverse including 1/n (e includes -log2 n)
+ *   fr_fft16 / fr_ifft16   s16 data and work, s32 arithmetic, s0.15
+ *                          twiddles; 3 bits of headroom per pass
+ *   fr_rfft(f, x, work)    n real samples in x -> bins 0 .. n/2, packed:
+ *                          x[0] = X[0], x[1] = X[n/2] (both real), then
+ *                          X[k] at x[2k], x[2k + 1] for 0 < k < n/2.
+ *                          work holds n s32; needs n >= 4.
+ *
+ * Twiddles are s1.30 from fr_sincos_bam32. An uninitialised or invalid
+ * fr_fft_t (or a NULL buffer) leaves x untouched and returns 0.
+ */
+#ifndef FR_NO_ARRAY
+#define FR_FFT_TW_LEN(n)    (3 * (n) / 2)   /* s32 words of twiddle table */
+
+typedef struct fr_fft_s {
+    s32 *tw;          /* W_n^k, k < 3n/4: cos, -sin pairs in s1.30 */
+    u32  n;           /* 0 if fr_fft_init rejected the size */
+    u16  log2n;
+} fr_fft_t;
+
+  void fr_fft_init(fr_fft_t *f, u32 n, s32 *tw);
+  s32  fr_fft(const fr_fft_t *f, s32 *x, s32 *work);
+  s32  fr_ifft(const fr_fft_t *f, s32 *x, s32 *work);
+  s32  fr_fft16(const fr_fft_t *f, s16 *x, s16 *work);
+  s32  fr_ifft16(const fr_fft_t *f, s16 *x, s16 *work);
+  s32  fr_rfft(const fr_fft_t *f, s32 *x, s32 *work);
+#endif
+
+/*===============================================
+ * Tone detectors — Goertzel and sliding DFT banks
+ *
+ * Single DFT bins for a few frequencies on many channels, without a full
+ * FFT. Tones are BAM increments per sample (FR_HZ2BAM_INC(hz, fs)) and
+ * the coefficients come from fr_cos_bam / fr_sin_bam, so one set serves
+ * every channel. Input is s16 interleaved by channel (in[frame * nch +
+ * ch]). State is struct of arrays: one row of nch values per tone, so
+ * with FR_SIMD_X86 a block update runs 8 channels per AVX2 register,
+ * bit-identical to the portable loop. Magnitudes are FR_hypot_fast8 of
+ * the bin, written to mag[tone * nch + ch] in input units: a tone of
+ * amplitude A on the bin frequency reads about A * n / 2.
+ *
+ *   u16 bam[2] = { FR_HZ2BAM_INC(697, 8000), FR_HZ2BAM_INC(1209, 8000) };
+ *   s32 st[FR_GOERTZEL_STATE(2, 64)], mag[2 * 64];
+ *   fr_goertzel_t g;
+ *   fr_goertzel_init(&g, bam, 2, 64, 205, st);     // 64 channels, n = 205
+ *   if (fr_goertzel_process(&g, pcm, frames, mag)) ...  // a window ended
+ *
+ * fr_goertzel_process runs s = x + 2 cos(w) s1 - s2 over windows of n
+ * frames. Whenever a window completes it writes mag (if not NULL) and
+ * starts the next one; it returns the number of windows completed in the
+ * call, and mag holds the last. The state is s32: keep
+ * n * max|x| / sin(w) below 2^31 (n = 205 at 8 kHz is fine down to 50 Hz).
+ * The filter is centred where cos w = fr_cos_bam(bam): within 0.1 Hz of
+ * the BAM frequency for the DTMF tones at 8 kHz, 0.5 Hz near 100 Hz.
+ *
+ * fr_sdft_process keeps the DFT of the most recent n frames current on
+ * every frame: each frame adds x e^(-jwm) and subtracts the product the
+ * frame leaving the window entered with. Every term is an exact integer
+ * product summed in s64, so the bins never drift. fr_sdft_mag reads the
+ * magnitudes after any block. hist holds the last n frames (n * nch s16).
+ *
+ * Bad arguments leave the bank inactive (n = 0): process calls do
+ * nothing and return 0.
+ */
+#ifndef FR_NO_ARRAY
+#define FR_GOERTZEL_STATE(ntone, nch)  (2 * (ntone) * (nch))   /* s32 words */
+#define FR_SDFT_ACC(ntone, nch)        (2 * (ntone) * (nch))   /* s64 words */
+
+typedef struct fr_goertzel_s {
+    const u16 *bam;   /* tone frequencies, BAM per sample */
+    s32 *state;       /* s1, s2 rows per tone */
+    u32  ntone;
+    u32  nch;
+    u32  n;           /* window length in frames, 0 if inactive */
+    u32  count;       /* frames into the current window */
+} fr_goertzel_t;
+
+typedef struct fr_sdft_s {
+    const u16 *bam;   /* tone frequencies, BAM per sample */
+    s64 *acc;         /* re, im rows per tone, input * 2^15 */
+    s16 *hist;        /* last n frames, in[] layout */
+    u32  ntone;
+    u32  nch;
+    u32  n;           /* window length in frames, 0 if inactive */
+    u32  pos;         /* hist frame of the oldest sample */
+    u16  frame;       /* frames processed, mod 2^16 (twiddle phase) */
+} fr_sdft_t;
+
+  void fr_goertzel_init(fr_goertzel_t *g, const u16 *bam, u32 ntone, u32 nch,
+                        u32 n, s32 *state);
+  void fr_goertzel_reset(fr_goertzel_t *g);
+  u32  fr_goertzel_process(fr_goertzel_t *g, const s16 *in, u32 frames, s32 *mag);
+  void fr_sdft_init(fr_sdft_t *s, const u16 *bam, u32 ntone, u32 nch, u32 n,
+                    s64 *acc, s16 *hist);
+  void fr_sdft_reset(fr_sdft_t *s);
+  void fr_sdft_process(fr_sdft_t *s, const s16 *in, u32 frames);
+  void fr_sdft_mag(const fr_sdft_t *s, s32 *mag);
+#endif
 
 /*================================================
  * Constants used in Trig tables, definitions
@@ -419,7 +709,8 @@ static inline s32 FR_div_rnd(s64 num, s32 den) {
  *   fr_sin_deg(deg, radix)  — sin of fixed-radix degrees, s15.16 result
  *   fr_tan_deg(deg, radix)  — tan of fixed-radix degrees, s15.16 result
  *
- * All go through the same 129-entry quadrant table with linear interpolation.
+ * All go through the same quadrant table with linear interpolation (129
+ * entries by default; FR_TRIG_TABLE_BITS selects 65..513 at build time).
  * Worst-case error: ~2 LSB in s15.16 (~3e-5 absolute), except at the four
  * cardinal angles where the result is exact.
  *
@@ -437,6 +728,112 @@ static inline s32 FR_div_rnd(s64 num, s32 den) {
   s32 fr_sin(s32 rad, u16 radix);
   s32 fr_tan(s32 rad, u16 radix);
 
+#ifndef FR_LEAN
+/*===============================================
+ * Fused sine + cosine
+ *
+ *   fr_sincos_bam(bam, &s, &c)          — one quadrant decode, both outputs
+ *   fr_sincos(rad, radix, &s, &c)       — one range reduction, one BAM angle
+ *   fr_sincos_deg(deg, radix, &s, &c)   — degree form
+ *
+ * Outputs are s15.16 like the single functions. Either pointer may be NULL.
+ * fr_sincos_bam and fr_sincos_deg are bit-identical to the separate calls.
+ * fr_sincos: sin is bit-identical to fr_sin; cos shares sin's BAM angle so
+ * it may differ from fr_cos by one BAM step of rounding (≤ 8 LSB).
+ */
+  void fr_sincos_bam(u16 bam, s32 *s, s32 *c);
+  void fr_sincos(s32 rad, u16 radix, s32 *s, s32 *c);
+  void fr_sincos_deg(s32 deg, u16 radix, s32 *s, s32 *c);
+
+/*===============================================
+ * High-precision trig: u32 phase in, s1.30 out
+ *
+ *   fr_sin_bam32(phase)              — sin, s1.30 result
+ *   fr_cos_bam32(phase)              — cos, s1.30 result
+ *   fr_sincos_bam32(phase, &s, &c)   — both, one table lookup pair
+ *
+ * phase is a 32-bit BAM: 2^32 = one full turn, so the top 16 bits are the
+ * ordinary u16 BAM (FR_BAM2PHASE32) and the u0.32 phase accumulators of
+ * the oscillator bank (FR_HZ2PHASE_INC) feed these directly.
+ * Result is s1.30: 1.0 = FR_TRIG32_ONE (2^30), exact at the cardinals.
+ *
+ * A 257-entry s1.30 sine table (1 KB) holds both sin and cos of each
+ * 1/256-quadrant grid point; the offset d from the grid point is added
+ * with the angle-sum identity and a cubic Taylor correction:
+ *   sin(x0 + d) = s0 + c0*d - s0*d^2/2 - c0*d^3/6
+ * Max error ≤ 1.2 LSB of s1.30 (~1.1e-9) versus ~4.4e-5 for fr_sin_bam,
+ * for about twice the time per call (a few 64-bit multiplies). Meant for
+ * FFT twiddles, long rotation chains and coordinate integration.
+ */
+#define FR_TRIG32_ONE           ((s32)1 << 30)
+#define FR_BAM2PHASE32(bam)     ((u32)(u16)(bam) << 16)
+
+/* FR_HZ2PHASE_INC(hz, sample_rate)
+ * Per-sample increment for a u32 phase accumulator (u0.32 of a cycle).
+ * The top 16 bits of the accumulator are the BAM phase, so this is
+ * FR_HZ2BAM_INC with 16 extra fraction bits:
+ *
+ *   u32 phase = 0;
+ *   u32 inc   = FR_HZ2PHASE_INC(440, 48000);      // 39370533
+ *   for (...) { sample = fr_sin_bam((u16)(phase >> 16)); phase += inc; }
+ *
+ * For fractional frequencies scale both arguments by the same factor,
+ * e.g. 440.5 Hz: FR_HZ2PHASE_INC(44050, 4800000). Requires hz < sample_rate.
+ *
+ * Side-effect note: hz and sample_rate are evaluated once each.
+ */
+#define FR_HZ2PHASE_INC(hz, sample_rate)  ((u32)((((u64)(hz)) << 32) / (u32)(sample_rate)))
+
+  s32  fr_sin_bam32(u32 phase);
+  s32  fr_cos_bam32(u32 phase);
+  void fr_sincos_bam32(u32 phase, s32 *s, s32 *c);
+#endif
+
+/*===============================================
+ * Array (batch) API
+ *
+ * Define FR_NO_ARRAY before including this header to exclude the array
+ * entry points below (and the other *_array functions in this file).
+ * FR_LEAN implies FR_NO_ARRAY.
+ *
+ *   fr_sin_bam_array(bam, out, n)  — out[i] = fr_sin_bam(bam[i]), i < n
+ *   fr_cos_bam_array(bam, out, n)  — out[i] = fr_cos_bam(bam[i]), i < n
+ *   fr_tan_bam_array(bam, out, n)  — out[i] = fr_tan_bam(bam[i]), i < n
+ *   fr_sincos_bam_array(bam, s, c, n) — s[i], c[i] = fr_sincos_bam(bam[i])
+ *
+ * Output is bit-identical to the scalar functions. The sin/cos loop body
+ * has no data-dependent branches (quadrant mirror, sign and small-angle
+ * choice are selects) so compilers can unroll and auto-vectorize it.
+ * Output is s32 because the cardinal values ±FR_TRIG_ONE do not fit in
+ * s16. NULL pointers are ignored (no-op).
+ *
+ * x86 SIMD (opt-in): build FR_math.c with -DFR_SIMD_X86 (GCC or Clang) to
+ * add AVX2 (8 lanes, hardware gathers) and SSE4.1 (4 lanes) kernels for
+ * the array functions. The best one is picked at run time via cpuid, with
+ * the portable loop as fallback; results stay bit-identical.
+ *
+ *   fr_simd_x86_level()       — kernel level in use: FR_SIMD_NONE/SSE41/AVX2
+ *   fr_simd_x86_limit(level)  — cap the level (A/B timing, testing fallbacks)
+ *
+ * The cpuid probe runs once at program load, so the kernels are safe to
+ * call from several threads. fr_simd_x86_limit() is an atomic store and
+ * may be called at any time; a call already running keeps its kernel.
+ */
+#ifndef FR_NO_ARRAY
+  void fr_sin_bam_array(const u16 *bam, s32 *out, u32 n);
+  void fr_cos_bam_array(const u16 *bam, s32 *out, u32 n);
+  void fr_tan_bam_array(const u16 *bam, s32 *out, u32 n);
+  void fr_sincos_bam_array(const u16 *bam, s32 *s, s32 *c, u32 n);
+
+#ifdef FR_SIMD_X86
+#define FR_SIMD_NONE   (0)
+#define FR_SIMD_SSE41  (1)
+#define FR_SIMD_AVX2   (2)
+  int  fr_simd_x86_level(void);
+  void fr_simd_x86_limit(int max_level);
+#endif
+#endif /* FR_NO_ARRAY */
+
 /* Integer degrees -> BAM using division (exact at all multiples of 45 deg). */
 #define FR_DEG2BAM_I(deg) ((u16)((((s32)(deg) << 16) + ((deg) >= 0 ? 180 : -180)) / 360))
 
@@ -473,6 +870,8 @@ static inline s32 FR_div_rnd(s64 num, s32 den) {
    * FR_atan2 returns radians at radix 16 (s15.16).
    * Range: acos [0, pi], asin [-pi/2, pi/2],
    *        atan [-pi/2, pi/2], atan2 [-pi, pi].
+   * FR_acos / FR_asin take radix 0..30 and out_radix 0..29 (acos) or
+   * 0..30 (asin); other radices return FR_DOMAIN_ERROR.
    */
   s32 FR_acos(s32 input, u16 radix, u16 out_radix);
   s32 FR_asin(s32 input, u16 radix, u16 out_radix);
@@ -500,6 +899,23 @@ static inline s32 FR_div_rnd(s64 num, s32 den) {
 #define FR_EXP_FAST(input, radix)   (FR_pow2(FR_SLOG2E(input), radix))
 #define FR_POW10_FAST(input, radix) (FR_pow2(FR_SLOG2_10(input), radix))
 
+/* Array (batch) exp / log — out[i] = scalar(in[i]) for i < n.
+ *   FR_pow2_array  / FR_exp_array / FR_pow10_array  ≡ FR_pow2 / FR_EXP / FR_POW10
+ *   FR_log2_array  / FR_ln_array  / FR_log10_array  ≡ FR_log2 / FR_ln / FR_log10
+ * Bit-identical to the scalar forms, sentinels included (FR_OVERFLOW_POS,
+ * underflow to 0, FR_LOG2MIN). in and out may be the same buffer; NULL
+ * pointers are ignored. With FR_SIMD_X86 they use AVX2 when available
+ * (SSE4.1-only CPUs take the portable loop).
+ */
+#ifndef FR_NO_ARRAY
+  void FR_pow2_array(const s32 *in, s32 *out, u32 n, u16 radix);
+  void FR_exp_array(const s32 *in, s32 *out, u32 n, u16 radix);
+  void FR_pow10_array(const s32 *in, s32 *out, u32 n, u16 radix);
+  void FR_log2_array(const s32 *in, s32 *out, u32 n, u16 radix, u16 output_radix);
+  void FR_ln_array(const s32 *in, s32 *out, u32 n, u16 radix, u16 output_radix);
+  void FR_log10_array(const s32 *in, s32 *out, u32 n, u16 radix, u16 output_radix);
+#endif
+
 /*===============================================
  * Formatted output and string parsing
  *
@@ -530,25 +946,82 @@ static inline s32 FR_div_rnd(s64 num, s32 den) {
  * Algorithm: digit-by-digit isqrt on a 64-bit accumulator (no division,
  * at most 32 iterations). Rounds to nearest.
  *
+ * Build FR_math.c with -DFR_SQRT_NEWTON to use a table-seeded Newton
+ * isqrt instead (multiplies, no loop). Results are identical; it is
+ * several times faster on 64-bit hosts with a fast multiplier.
+ *
  * Domain error sentinel: input < 0 (sqrt) returns FR_DOMAIN_ERROR. Caller
  * can check `result == FR_DOMAIN_ERROR` to detect domain errors.
+ *
+ * Reciprocal square root and normalisation use a table seed and two
+ * Newton steps (no division, no loop; ~2^-29 relative):
+ *
+ *   FR_rsqrt(x, r)   1/sqrt(x) at radix r. Error <= 1 LSB for results
+ *                    below 2^28. x < 0 → FR_DOMAIN_ERROR; x == 0 or a
+ *                    result above s32 → FR_OVERFLOW_POS.
+ *   fr_normalize2(x, y, r, &nx, &ny)
+ *                    (x, y) / |(x, y)| at radix r, <= 1 LSB per
+ *                    component for r <= 27. (0, 0) → (0, 0); NULL
+ *                    outputs are skipped.
+ *
+ * Array forms (excluded by FR_NO_ARRAY) apply the same per element;
+ * outputs may alias the inputs.
  */
   s32 FR_sqrt(s32 input, u16 radix);
+  s32 FR_rsqrt(s32 input, u16 radix);
 #ifndef FR_LEAN
   s32 FR_hypot(s32 x, s32 y, u16 radix);
+  s32 FR_hypot3(s32 x, s32 y, s32 z, u16 radix);     /* sqrt(x*x + y*y + z*z) */
+  void fr_normalize2(s32 x, s32 y, u16 radix, s32 *nx, s32 *ny);
+#endif
+#ifndef FR_NO_ARRAY
+  void FR_rsqrt_array(const s32 *in, s32 *out, u32 n, u16 radix);
+  void fr_normalize2_array(const s32 *x, const s32 *y, s32 *nx, s32 *ny, u32 n, u16 radix);
 #endif
 
   /* Fast approximate magnitude — shift-only, no multiply, no 64-bit.
    * Based on piecewise-linear approximation of sqrt(x*x + y*y).
    * See US Patent 6,567,777 B1 (Chatterjee, expired).
    *
-   *   FR_hypot_fast8(x, y)  8-segment, ~0.10% peak error
+   *   FR_hypot_fast8(x, y)      8-segment, ~0.10% peak error
+   *   FR_hypot3_fast8(x, y, z)  FR_hypot_fast8(FR_hypot_fast8(x, y), z),
+   *                             ~0.2% peak error
    *
    * Inputs are raw signed integers (or fixed-point at any radix — the
    * result is at the same radix as the inputs, just like FR_hypot).
    * No radix parameter needed because the algorithm is scale-invariant.
    */
   s32 FR_hypot_fast8(s32 x, s32 y);
+  s32 FR_hypot3_fast8(s32 x, s32 y, s32 z);
+
+  /* Batch magnitudes: out[i] = FR_hypot(x[i], y[i], radix) and so on,
+   * bit-identical to the scalar functions. The fast8 forms evaluate the
+   * segment fit with selects instead of branches, so they vectorize;
+   * with FR_SIMD_X86 all four use AVX2 when available. NULL pointers are
+   * a no-op; out may alias an input.
+   */
+#ifndef FR_NO_ARRAY
+  void FR_hypot_array(const s32 *x, const s32 *y, s32 *out, u32 n, u16 radix);
+  void FR_hypot3_array(const s32 *x, const s32 *y, const s32 *z, s32 *out, u32 n, u16 radix);
+  void FR_hypot_fast8_array(const s32 *x, const s32 *y, s32 *out, u32 n);
+  void FR_hypot3_fast8_array(const s32 *x, const s32 *y, const s32 *z, s32 *out, u32 n);
+#endif
+
+  /* Batch cartesian → polar. One abs/max/min per point feeds both the
+   * magnitude and the angle, i < n:
+   *
+   *   mag[i] = FR_hypot_fast8(x[i], y[i])        (same radix as x, y)
+   *   ang[i] = FR_atan2(y[i], x[i], out_radix)   (radians, bit-identical)
+   *   bam[i] = atan2 as u16 BAM, [0, 65535]      (within 1 BAM of the
+   *            radian result; feed straight into fr_sin_bam & co.)
+   *
+   * mag, ang / bam may be NULL to skip that output; NULL x or y is a
+   * no-op. With FR_SIMD_X86 they use AVX2 when available.
+   */
+#ifndef FR_NO_ARRAY
+  void fr_cart2polar_array(const s32 *x, const s32 *y, s32 *mag, s32 *ang, u32 n, u16 out_radix);
+  void fr_cart2polar_bam_array(const s32 *x, const s32 *y, s32 *mag, u16 *bam, u32 n);
+#endif
 
 /*===============================================
  * Wave generators and ADSR envelope
@@ -643,6 +1116,52 @@ typedef struct fr_adsr_s {
   void fr_adsr_release(fr_adsr_t *env);
   s16  fr_adsr_step(fr_adsr_t *env);
 
+/*===============================================
+ * Oscillator bank — N voices rendered per block
+ *
+ * Struct of caller-allocated arrays, one entry per voice (no malloc).
+ * Each voice: u32 phase accumulator, u32 increment (FR_HZ2PHASE_INC),
+ * s0.15 amplitude, waveform selector and one shape parameter (duty for
+ * FR_OSC_PWM, break point for FR_OSC_TRI_MORPH; both BAM).
+ *
+ *   u32 ph[8], inc[8]; s16 amp[8]; u8 wv[8]; u16 prm[8];
+ *   fr_osc_bank_t bank;
+ *   fr_osc_bank_init(&bank, 8, ph, inc, amp, wv, prm);
+ *   fr_osc_set(&bank, 0, FR_OSC_SIN, FR_HZ2PHASE_INC(440, 48000), 16384, 0);
+ *   fr_osc_bank_render(&bank, buf, 256, FR_OSC_INTERLEAVED);  // buf: 8*256
+ *
+ * Layouts (n = voices, frames = block length):
+ *   FR_OSC_INTERLEAVED  out[frame * n + voice]
+ *   FR_OSC_PLANAR       out[voice * frames + frame]
+ *
+ * Output sample = wave(phase >> 16) * amp, rounded to s0.15. Phases are
+ * written back after the block, so consecutive calls are seamless.
+ */
+#define FR_OSC_SIN        (0)
+#define FR_OSC_SQR        (1)
+#define FR_OSC_PWM        (2)   /* param = duty (BAM)        */
+#define FR_OSC_TRI        (3)
+#define FR_OSC_SAW        (4)
+#define FR_OSC_TRI_MORPH  (5)   /* param = break point (BAM), unipolar */
+
+#define FR_OSC_INTERLEAVED (0)
+#define FR_OSC_PLANAR      (1)
+
+typedef struct fr_osc_bank_s {
+    u32  n;           /* number of voices */
+    u32 *phase;       /* phase accumulators, u0.32 of a cycle */
+    u32 *inc;         /* per-sample phase increments, u0.32 */
+    s16 *amp;         /* amplitudes, s0.15 */
+    u8  *wave;        /* FR_OSC_* */
+    u16 *param;       /* duty / break point (BAM) */
+} fr_osc_bank_t;
+
+  void fr_osc_bank_init(fr_osc_bank_t *bank, u32 n,
+                        u32 *phase, u32 *inc, s16 *amp, u8 *wave, u16 *param);
+  void fr_osc_set(fr_osc_bank_t *bank, u32 voice,
+                  u8 wave, u32 inc, s16 amp, u16 param);
+  void fr_osc_bank_render(fr_osc_bank_t *bank, s16 *out, u32 frames, u8 layout);
+
 #endif /* FR_NO_WAVES */
 
 #ifdef __cplusplus
@@ -32,6 +32,7 @@
 
 #include "FR_math_2D.h"
 #include "FR_math.h"
+#include "FR_simd_x86.h"   // FR_SIMD_X86_ACTIVE: AVX2 batch point transforms
 // namespace FR_MATH {
 //=======================================================
 //  Matrix Functions
@@ -103,20 +104,24 @@ bool FR_Matrix2D_CPT ::inv()
 // set up an integer rotation in degrees.
 void FR_Matrix2D_CPT ::setrotate(s16 deg)
 {
-	m00 = (FR_CosI(deg)) >> (FR_TRIG_OUT_PREC - radix);
-	m01 = -(FR_SinI(deg)) >> (FR_TRIG_OUT_PREC - radix);
-	m10 = (FR_SinI(deg)) >> (FR_TRIG_OUT_PREC - radix);
-	m11 = (FR_CosI(deg)) >> (FR_TRIG_OUT_PREC - radix);
+	s32 s, c;
+	fr_sincos_bam(FR_DEG2BAM_I(deg), &s, &c);
+	m00 = c >> (FR_TRIG_OUT_PREC - radix);
+	m01 = -s >> (FR_TRIG_OUT_PREC - radix);
+	m10 = s >> (FR_TRIG_OUT_PREC - radix);
+	m11 = c >> (FR_TRIG_OUT_PREC - radix);
 	checkfast();
 }
 //================================================================
 // set up a rotation with fixed radix input precision
 void FR_Matrix2D_CPT ::setrotate(s16 deg, u16 deg_radix)
 {
-	m00 = (FR_Cos(deg, deg_radix)) >> (FR_TRIG_OUT_PREC - radix);
-	m01 = -(FR_Sin(deg, deg_radix)) >> (FR_TRIG_OUT_PREC - radix);
-	m10 = (FR_Sin(deg, deg_radix)) >> (FR_TRIG_OUT_PREC - radix);
-	m11 = (FR_Cos(deg, deg_radix)) >> (FR_TRIG_OUT_PREC - radix);
+	s32 s, c;
+	fr_sincos_deg(deg, deg_radix, &s, &c);
+	m00 = c >> (FR_TRIG_OUT_PREC - radix);
+	m01 = -s >> (FR_TRIG_OUT_PREC - radix);
+	m10 = s >> (FR_TRIG_OUT_PREC - radix);
+	m11 = c >> (FR_TRIG_OUT_PREC - radix);
 	checkfast();
 }
 //================================================================
@@ -146,6 +151,58 @@ void FR_Matrix2D_CPT ::sub(const FR_Matrix2D_CPT *pSub)
 	checkfast();
 }
 
+//=======================================================
+// Compose this = this * pMul: transforming a point by the result is the
+// same as transforming it by pMul and then by this, so a parent matrix
+// times its child's gives the child's world transform in one matrix.
+// pMul may be at a different radix (0..31); the result keeps this->radix.
+// Each element is a 64-bit sum of products rounded once from radix
+// radix + pMul->radix and saturated to s32.  pMul may be this.
+
+// (a*b + c*d) / 2^r rounded to nearest.  Each product is at most 2^62,
+// so only the r == 0 sum (-2^31)^2 + (-2^31)^2 can leave s64; that one
+// is returned as 2^62, which saturates the same way.
+static s64 fr_m2_dot(s32 a, s32 b, s32 c, s32 d, u16 r)
+{
+	s64 p = (s64)a * b, q = (s64)c * d;
+	s64 m, h;
+	if (r == 0)
+		return (p == ((s64)1 << 62) && q == p) ? p : p + q;
+	m = ((s64)1 << r) - 1;
+	h = (s64)1 << (r - 1);
+	return (p >> r) + (q >> r) + (((p & m) + (q & m) + h) >> r);
+}
+
+static s32 fr_m2_sat(s64 v)
+{
+	if (v > (s64)FR_OVERFLOW_POS)
+		return FR_OVERFLOW_POS;
+	if (v < (s64)FR_OVERFLOW_NEG)
+		return FR_OVERFLOW_NEG;
+	return (s32)v;
+}
+
+void FR_Matrix2D_CPT ::mul(const FR_Matrix2D_CPT *pMul)
+{
+	u16 r = pMul->radix;
+	s32 b00 = pMul->m00, b01 = pMul->m01, b02 = pMul->m02;
+	s32 b10 = pMul->m10, b11 = pMul->m11, b12 = pMul->m12;
+	s32 n00 = fr_m2_sat(fr_m2_dot(m00, b00, m01, b10, r));
+	s32 n01 = fr_m2_sat(fr_m2_dot(m00, b01, m01, b11, r));
+	s32 n02 = fr_m2_sat(fr_m2_dot(m00, b02, m01, b12, r) + m02);
+	s32 n10 = fr_m2_sat(fr_m2_dot(m10, b00, m11, b10, r));
+	s32 n11 = fr_m2_sat(fr_m2_dot(m10, b01, m11, b11, r));
+	s32 n12 = fr_m2_sat(fr_m2_dot(m10, b02, m11, b12, r) + m12);
+
+	m00 = n00;
+	m01 = n01;
+	m02 = n02;
+	m10 = n10;
+	m11 = n11;
+	m12 = n12;
+	checkfast();
+}
+
 //=======================================================
 // set a matrix with the provided data
 
@@ -175,6 +232,12 @@ FR_Matrix2D_CPT &FR_Matrix2D_CPT ::operator-=(const FR_Matrix2D_CPT &nM)
 	return *this;
 }
 
+FR_Matrix2D_CPT &FR_Matrix2D_CPT ::operator*=(const FR_Matrix2D_CPT &nM)
+{
+	mul(&nM);
+	return *this;
+}
+
 FR_Matrix2D_CPT &FR_Matrix2D_CPT ::operator*=(const s32 &X)
 {
 	m00 = FR_FixMulSat(m00, X);
@@ -199,4 +262,558 @@ FR_Matrix2D_CPT &FR_Matrix2D_CPT ::operator=(const FR_Matrix2D_CPT &nM)
 	checkfast();
 	return *this;
 }
+//=======================================================
+// Batch point transforms
+//
+// Each output is (x*m00 + y*m01 + m02) >> r with the products and sums
+// wrapping in 32 bits, exactly as the scalar XFormPtI computes them; the
+// portable loops do the arithmetic in u32 so the wrap is defined.  The
+// fast flag picks the loop once (two multiplies per point instead of
+// four).  The AVX2 kernels take 8 points per step: mullo_epi32 products,
+// an arithmetic shift, and for s16 output the low 16 bits of each lane.
+// Interleaved data uses the pair-swapped vector (y, x, ...) against
+// (m01, m10, ...) so x and y lanes come out of the same three ops.
+
+static inline s32 fr_xf2(s32 x, s32 y, s32 a, s32 b, s32 c, u16 r)
+{
+	return (s32)((u32)x * (u32)a + (u32)y * (u32)b + (u32)c) >> r;
+}
+
+static inline s32 fr_xf1(s32 x, s32 a, s32 c, u16 r)
+{
+	return (s32)((u32)x * (u32)a + (u32)c) >> r;
+}
+
+#ifdef FR_SIMD_X86_ACTIVE
+// x*a + y*b + c >> r on 8 lanes (y, b unused in fast mode)
+__attribute__((target("avx2")))
+static inline __m256i fr_xf8_avx2(__m256i x, __m256i y, __m256i a, __m256i b, __m256i c,
+                                  __m128i r, int fast)
+{
+	__m256i v = _mm256_add_epi32(_mm256_mullo_epi32(x, a), c);
+	if (!fast)
+		v = _mm256_add_epi32(v, _mm256_mullo_epi32(y, b));
+	return _mm256_sra_epi32(v, r);
+}
+
+// coefficients for interleaved (x, y) pairs: k[0] = (m00, m11, ...),
+// k[1] = (m01, m10, ...), k[2] = (m02, m12, ...)
+__attribute__((target("avx2")))
+static inline void fr_xfpair_coef_avx2(const FR_Matrix2D_CPT *m, __m256i *k)
+{
+	k[0] = _mm256_setr_epi32(m->m00, m->m11, m->m00, m->m11, m->m00, m->m11, m->m00, m->m11);
+	k[1] = _mm256_setr_epi32(m->m01, m->m10, m->m01, m->m10, m->m01, m->m10, m->m01, m->m10);
+	k[2] = _mm256_setr_epi32(m->m02, m->m12, m->m02, m->m12, m->m02, m->m12, m->m02, m->m12);
+}
+
+// 4 interleaved points: the y lanes get x*m10 + y*m11 + m12
+__attribute__((target("avx2")))
+static inline __m256i fr_xfpair8_avx2(__m256i v, const __m256i *k, __m128i r, int fast)
+{
+	return fr_xf8_avx2(v, _mm256_shuffle_epi32(v, 0xB1), k[0], k[1], k[2], r, fast);
+}
+
+// low 16 bits of each s32 lane of lo, hi, in order
+__attribute__((target("avx2")))
+static inline __m256i fr_trunc16_avx2(__m256i lo, __m256i hi)
+{
+	const __m256i mask = _mm256_set1_epi32(0xFFFF);
+	__m256i p = _mm256_packus_epi32(_mm256_and_si256(lo, mask), _mm256_and_si256(hi, mask));
+	return _mm256_permute4x64_epi64(p, 0xD8);
+}
+
+__attribute__((target("avx2")))
+static u32 fr_xfpts_avx2(const FR_Matrix2D_CPT *m, const s32 *xs, const s32 *ys,
+                         s32 *xps, s32 *yps, u32 n, u16 r)
+{
+	__m256i m00 = _mm256_set1_epi32(m->m00), m01 = _mm256_set1_epi32(m->m01);
+	__m256i m02 = _mm256_set1_epi32(m->m02), m10 = _mm256_set1_epi32(m->m10);
+	__m256i m11 = _mm256_set1_epi32(m->m11), m12 = _mm256_set1_epi32(m->m12);
+	__m128i sh = _mm_cvtsi32_si128(r);
+	int fast = m->fast;
+	u32 i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m256i x = _mm256_loadu_si256((const __m256i *)(const void *)(xs + i));
+		__m256i y = _mm256_loadu_si256((const __m256i *)(const void *)(ys + i));
+		__m256i xp = fr_xf8_avx2(x, y, m00, m01, m02, sh, fast);
+		__m256i yp = fast ? fr_xf8_avx2(y, x, m11, m10, m12, sh, 1)
+		                     : fr_xf8_avx2(x, y, m10, m11, m12, sh, 0);
+		_mm256_storeu_si256((__m256i *)(void *)(xps + i), xp);
+		_mm256_storeu_si256((__m256i *)(void *)(yps + i), yp);
+	}
+	return i;
+}
+
+__attribute__((target("avx2")))
+static u32 fr_xfpairs_avx2(const FR_Matrix2D_CPT *m, const s32 *xy, s32 *xyp, u32 n, u16 r)
+{
+	__m128i sh = _mm_cvtsi32_si128(r);
+	__m256i k[3];
+	int fast = m->fast;
+	u32 i = 0;
+	fr_xfpair_coef_avx2(m, k);
+	for (; i + 4 <= n; i += 4) {
+		__m256i v = _mm256_loadu_si256((const __m256i *)(const void *)(xy + 2 * i));
+		_mm256_storeu_si256((__m256i *)(void *)(xyp + 2 * i), fr_xfpair8_avx2(v, k, sh, fast));
+	}
+	return i;
+}
+
+__attribute__((target("avx2")))
+static u32 fr_xfpts16_avx2(const FR_Matrix2D_CPT *m, const s16 *xs, const s16 *ys,
+                           s16 *xps, s16 *yps, u32 n)
+{
+	__m256i m00 = _mm256_set1_epi32(m->m00), m01 = _mm256_set1_epi32(m->m01);
+	__m256i m02 = _mm256_set1_epi32(m->m02), m10 = _mm256_set1_epi32(m->m10);
+	__m256i m11 = _mm256_set1_epi32(m->m11), m12 = _mm256_set1_epi32(m->m12);
+	__m128i sh = _mm_cvtsi32_si128(m->radix);
+	int fast = m->fast;
+	u32 i = 0;
+	for (; i + 16 <= n; i += 16) {
+		__m256i x16 = _mm256_loadu_si256((const __m256i *)(const void *)(xs + i));
+		__m256i y16 = _mm256_loadu_si256((const __m256i *)(const void *)(ys + i));
+		__m256i xo[2], yo[2];
+		int h;
+		for (h = 0; h < 2; h++) {
+			__m128i xh = h ? _mm256_extracti128_si256(x16, 1) : _mm256_castsi256_si128(x16);
+			__m128i yh = h ? _mm256_extracti128_si256(y16, 1) : _mm256_castsi256_si128(y16);
+			__m256i x = _mm256_cvtepi16_epi32(xh), y = _mm256_cvtepi16_epi32(yh);
+			xo[h] = fr_xf8_avx2(x, y, m00, m01, m02, sh, fast);
+			yo[h] = fast ? fr_xf8_avx2(y, x, m11, m10, m12, sh, 1)
+			                : fr_xf8_avx2(x, y, m10, m11, m12, sh, 0);
+		}
+		_mm256_storeu_si256((__m256i *)(void *)(xps + i), fr_trunc16_avx2(xo[0], xo[1]));
+		_mm256_storeu_si256((__m256i *)(void *)(yps + i), fr_trunc16_avx2(yo[0], yo[1]));
+	}
+	return i;
+}
+
+__attribute__((target("avx2")))
+static u32 fr_xfpairs16_avx2(const FR_Matrix2D_CPT *m, const s16 *xy, s16 *xyp, u32 n)
+{
+	__m128i sh = _mm_cvtsi32_si128(m->radix);
+	__m256i k[3];
+	int fast = m->fast;
+	u32 i = 0;
+	fr_xfpair_coef_avx2(m, k);
+	for (; i + 8 <= n; i += 8) {
+		__m256i v = _mm256_loadu_si256((const __m256i *)(const void *)(xy + 2 * i));
+		__m256i lo = fr_xfpair8_avx2(_mm256_cvtepi16_epi32(_mm256_castsi256_si128(v)), k, sh, fast);
+		__m256i hi = fr_xfpair8_avx2(_mm256_cvtepi16_epi32(_mm256_extracti128_si256(v, 1)), k, sh, fast);
+		_mm256_storeu_si256((__m256i *)(void *)(xyp + 2 * i), fr_trunc16_avx2(lo, hi));
+	}
+	return i;
+}
+#endif
+
+void FR_Matrix2D_CPT ::XFormPtsI(const s32 *xs, const s32 *ys, s32 *xps, s32 *yps, u32 n, u16 r)
+{
+	u32 i = 0;
+	s32 a, b, c, d, e, f;
+	if (!xs || !ys || !xps || !yps)
+		return;
+	a = m00; b = m01; c = m02; d = m10; e = m11; f = m12;
+#ifdef FR_SIMD_X86_ACTIVE
+	if (fr_simd_x86_level() >= FR_SIMD_AVX2)
+		i = fr_xfpts_avx2(this, xs, ys, xps, yps, n, r);
+#endif
+	if (fast)
+	{
+		for (; i < n; i++)
+		{
+			s32 x = xs[i], y = ys[i];
+			xps[i] = fr_xf1(x, a, c, r);
+			yps[i] = fr_xf1(y, e, f, r);
+		}
+	}
+	else
+	{
+		for (; i < n; i++)
+		{
+			s32 x = xs[i], y = ys[i];
+			xps[i] = fr_xf2(x, y, a, b, c, r);
+			yps[i] = fr_xf2(x, y, d, e, f, r);
+		}
+	}
+}
+
+void FR_Matrix2D_CPT ::XFormPtsI(const s32 *xy, s32 *xyp, u32 n, u16 r)
+{
+	u32 i = 0;
+	s32 a, b, c, d, e, f;
+	if (!xy || !xyp)
+		return;
+	a = m00; b = m01; c = m02; d = m10; e = m11; f = m12;
+#ifdef FR_SIMD_X86_ACTIVE
+	if (fr_simd_x86_level() >= FR_SIMD_AVX2)
+		i = fr_xfpairs_avx2(this, xy, xyp, n, r);
+#endif
+	if (fast)
+	{
+		for (; i < n; i++)
+		{
+			s32 x = xy[2 * i], y = xy[2 * i + 1];
+			xyp[2 * i] = fr_xf1(x, a, c, r);
+			xyp[2 * i + 1] = fr_xf1(y, e, f, r);
+		}
+	}
+	else
+	{
+		for (; i < n; i++)
+		{
+			s32 x = xy[2 * i], y = xy[2 * i + 1];
+			xyp[2 * i] = fr_xf2(x, y, a, b, c, r);
+			xyp[2 * i + 1] = fr_xf2(x, y, d, e, f, r);
+		}
+	}
+}
+
+void FR_Matrix2D_CPT ::XFormPtsI16(const s16 *xs, const s16 *ys, s16 *xps, s16 *yps, u32 n)
+{
+	u32 i = 0;
+	s32 a, b, c, d, e, f;
+	u16 r;
+	if (!xs || !ys || !xps || !yps)
+		return;
+	a = m00; b = m01; c = m02; d = m10; e = m11; f = m12; r = radix;
+#ifdef FR_SIMD_X86_ACTIVE
+	if (fr_simd_x86_level() >= FR_SIMD_AVX2)
+		i = fr_xfpts16_avx2(this, xs, ys, xps, yps, n);
+#endif
+	if (fast)
+	{
+		for (; i < n; i++)
+		{
+			s32 x = xs[i], y = ys[i];
+			xps[i] = (s16)fr_xf1(x, a, c, r);
+			yps[i] = (s16)fr_xf1(y, e, f, r);
+		}
+	}
+	else
+	{
+		for (; i < n; i++)
+		{
+			s32 x = xs[i], y = ys[i];
+			xps[i] = (s16)fr_xf2(x, y, a, b, c, r);
+			yps[i] = (s16)fr_xf2(x, y, d, e, f, r);
+		}
+	}
+}
+
+void FR_Matrix2D_CPT ::XFormPtsI16(const s16 *xy, s16 *xyp, u32 n)
+{
+	u32 i = 0;
+	s32 a, b, c, d, e, f;
+	u16 r;
+	if (!xy || !xyp)
+		return;
+	a = m00; b = m01; c = m02; d = m10; e = m11; f = m12; r = radix;
+#ifdef FR_SIMD_X86_ACTIVE
+	if (fr_simd_x86_level() >= FR_SIMD_AVX2)
+		i = fr_xfpairs16_avx2(this, xy, xyp, n);
+#endif
+	if (fast)
+	{
+		for (; i < n; i++)
+		{
+			s32 x = xy[2 * i], y = xy[2 * i + 1];
+			xyp[2 * i] = (s16)fr_xf1(x, a, c, r);
+			xyp[2 * i + 1] = (s16)fr_xf1(y, e, f, r);
+		}
+	}
+	else
+	{
+		for (; i < n; i++)
+		{
+			s32 x = xy[2 * i], y = xy[2 * i + 1];
+			xyp[2 * i] = (s16)fr_xf2(x, y, a, b, c, r);
+			xyp[2 * i + 1] = (s16)fr_xf2(x, y, d, e, f, r);
+		}
+	}
+}
+//=======================================================
+// Span iterator
+//
+// The start is x*m00 + y*m01 + m02*2^p and the step sx*m00 + sy*m01 (and
+// likewise for y), both exact in s64 at radix radix + p; the outputs drop
+// p + r bits.  Nothing is rounded, so a span of any length lands exactly
+// where the full transform would.
+
+void FR_Matrix2D_CPT ::SpanI(FR_Span2D *s, s32 x, s32 y, s32 sx, s32 sy, u16 p, u16 r)
+{
+	s64 k = (s64)1 << p;
+	if (!s)
+		return;
+	s->x = (s64)x * m00 + (s64)y * m01 + m02 * k;
+	s->y = (s64)x * m10 + (s64)y * m11 + m12 * k;
+	s->dx = (s64)sx * m00 + (s64)sy * m01;
+	s->dy = (s64)sx * m10 + (s64)sy * m11;
+	s->sh = (u16)(p + r);
+}
+
+void FR_Span2D::fill(s32 *xps, s32 *yps, u32 n)
+{
+	s64 a = x, b = y;
+	const s64 da = dx, db = dy;
+	const u16 r = sh;
+	u32 i;
+	if (!xps || !yps)
+		return;
+	for (i = 0; i < n; i++)
+	{
+		xps[i] = (s32)(a >> r);
+		yps[i] = (s32)(b >> r);
+		a += da;
+		b += db;
+	}
+	x = a;
+	y = b;
+}
+
+void FR_Matrix2D_CPT ::XFormSpanI(s32 x, s32 y, s32 *xps, s32 *yps, u32 n, u16 r)
+{
+	FR_Span2D s;
+	SpanI(&s, x, y, r);
+	s.fill(xps, yps, n);
+}
+//=======================================================
+// Affine image warp
+//
+// Inverse mapping: every destination pixel centre (x + 1/2, y + 1/2) goes
+// back through the inverse matrix to a source position.  The inverse is
+// formed from the exact s64 determinant and rounded once to radix 16 (no
+// det() / inv() precision loss at small radix); destination centres are the
+// radix-1 start of an FR_Span2D, so a tile row costs one SpanI and then two
+// additions per pixel.  Nearest takes the source pixel containing the
+// position; bilinear shifts it by half a pixel so the weights fall between
+// pixel centres and blends the four neighbours with FR_INTERP.  Coverage
+// is the same in both modes: a pixel is drawn when its position lies in
+// the source image, and bilinear clamps the neighbours at the edges.
+// Bounds are tested on the s64 span values so far-off positions never
+// wrap back into the image.
+
+#define FR_WARP_RADIX (16) // inverse matrix radix
+#define FR_WARP_FRAC (12)  // bilinear weight bits
+
+struct fr_warp_ctx
+{
+	const void *src;
+	void *dst;
+	s32 w, h, spitch, dpitch;
+	u32 fill;
+};
+
+typedef void (*fr_warp_row)(const fr_warp_ctx *c, const FR_Span2D *s, s32 x, s32 y, s32 n);
+
+// n / d at radix 16, rounded; false if it does not fit s32.  d is cut to
+// 40 significant bits first so that the remainder can take the 16 bits.
+static bool fr_warp_ratio(s64 n, s64 d, s32 *out)
+{
+	s64 q, rem, v;
+	int k = 0;
+	if (d < 0)
+	{
+		n = -n;
+		d = -d;
+	}
+	while ((d >> k) >= ((s64)1 << 40))
+		k++;
+	n >>= k;
+	d >>= k;
+	q = n / d;
+	rem = (n % d) * ((s64)1 << FR_WARP_RADIX);
+	if (q >= ((s64)1 << 15) || q < -((s64)1 << 15))
+		return false;
+	v = q * ((s64)1 << FR_WARP_RADIX) + ((rem >= 0) ? (rem + d / 2) / d : (rem - d / 2) / d);
+	if (v > (s64)FR_OVERFLOW_POS || v < (s64)FR_OVERFLOW_NEG)
+		return false;
+	*out = (s32)v;
+	return true;
+}
+
+// inverse of m at radix 16; bilinear moves the translation back half a pixel
+static bool fr_warp_inv(const FR_Matrix2D_CPT *m, int bilinear, FR_Matrix2D_CPT *inv)
+{
+	const s64 one = (s64)1 << m->radix;
+	s64 det = (s64)m->m00 * m->m11 - (s64)m->m01 * m->m10;
+	s64 h = bilinear ? (s64)1 << (FR_WARP_RADIX - 1) : 0;
+	s32 a[6];
+	if (0 == det)
+		return false;
+	if (!fr_warp_ratio((s64)m->m11 * one, det, &a[0]) ||
+	    !fr_warp_ratio(-(s64)m->m01 * one, det, &a[1]) ||
+	    !fr_warp_ratio((s64)m->m01 * m->m12 - (s64)m->m11 * m->m02, det, &a[2]) ||
+	    !fr_warp_ratio(-(s64)m->m10 * one, det, &a[3]) ||
+	    !fr_warp_ratio((s64)m->m00 * one, det, &a[4]) ||
+	    !fr_warp_ratio((s64)m->m10 * m->m02 - (s64)m->m00 * m->m12, det, &a[5]))
+		return false;
+	if ((s64)a[2] - h < (s64)FR_OVERFLOW_NEG || (s64)a[5] - h < (s64)FR_OVERFLOW_NEG)
+		return false;
+	inv->set(a[0], a[1], (s32)(a[2] - h), a[3], a[4], (s32)(a[5] - h), FR_WARP_RADIX);
+	return true;
+}
+
+static void fr_warp_row8n(const fr_warp_ctx *c, const FR_Span2D *s, s32 x, s32 y, s32 n)
+{
+	const u8 *src = (const u8 *)c->src;
+	u8 *d = (u8 *)c->dst + (s64)y * c->dpitch + x;
+	s64 u = s->x, v = s->y;
+	const s64 du = s->dx, dv = s->dy;
+	const u16 sh = s->sh;
+	s32 i;
+	for (i = 0; i < n; i++)
+	{
+		s64 xi = u >> sh, yi = v >> sh;
+		if ((u64)xi < (u64)c->w && (u64)yi < (u64)c->h)
+			d[i] = src[yi * c->spitch + xi];
+		else
+			d[i] = (u8)c->fill;
+		u += du;
+		v += dv;
+	}
+}
+
+static void fr_warp_row16n(const fr_warp_ctx *c, const FR_Span2D *s, s32 x, s32 y, s32 n)
+{
+	const u16 *src = (const u16 *)c->src;
+	u16 *d = (u16 *)c->dst + (s64)y * c->dpitch + x;
+	s64 u = s->x, v = s->y;
+	const s64 du = s->dx, dv = s->dy;
+	const u16 sh = s->sh;
+	s32 i;
+	for (i = 0; i < n; i++)
+	{
+		s64 xi = u >> sh, yi = v >> sh;
+		if ((u64)xi < (u64)c->w && (u64)yi < (u64)c->h)
+			d[i] = src[yi * c->spitch + xi];
+		else
+			d[i] = (u16)c->fill;
+		u += du;
+		v += dv;
+	}
+}
+
+// bilinear sample position (u, v) at radix FR_WARP_FRAC, half a pixel back:
+// the covering pixel is (u + 1/2) >> FRAC, the blend is between u >> FRAC
+// and the next pixel, clamped at the edges
+#define FR_WARP_BILERP(T)                                                      \
+	s64 a = u >> sh, b = v >> sh;                                              \
+	s64 xi = (a + (1 << (FR_WARP_FRAC - 1))) >> FR_WARP_FRAC;                  \
+	s64 yi = (b + (1 << (FR_WARP_FRAC - 1))) >> FR_WARP_FRAC;                  \
+	if ((u64)xi < (u64)c->w && (u64)yi < (u64)c->h)                            \
+	{                                                                          \
+		s32 x0 = (s32)(a >> FR_WARP_FRAC), y0 = (s32)(b >> FR_WARP_FRAC);      \
+		s32 fx = (s32)(a & ((1 << FR_WARP_FRAC) - 1));                         \
+		s32 fy = (s32)(b & ((1 << FR_WARP_FRAC) - 1));                         \
+		s32 x1 = (x0 + 1 < c->w) ? x0 + 1 : c->w - 1;                          \
+		s32 y1 = (y0 + 1 < c->h) ? y0 + 1 : c->h - 1;                          \
+		const T *r0, *r1;                                                      \
+		s32 top, bot;                                                          \
+		x0 = (x0 < 0) ? 0 : x0;                                                \
+		y0 = (y0 < 0) ? 0 : y0;                                                \
+		r0 = src + (s64)y0 * c->spitch;                                        \
+		r1 = src + (s64)y1 * c->spitch;                                        \
+		top = FR_INTERP((s32)r0[x0], (s32)r0[x1], fx, FR_WARP_FRAC);           \
+		bot = FR_INTERP((s32)r1[x0], (s32)r1[x1], fx, FR_WARP_FRAC);           \
+		d[i] = (T)FR_INTERP(top, bot, fy, FR_WARP_FRAC);                       \
+	}                                                                          \
+	else                                                                       \
+		d[i] = (T)c->fill;
+
+static void fr_warp_row8b(const fr_warp_ctx *c, const FR_Span2D *s, s32 x, s32 y, s32 n)
+{
+	const u8 *src = (const u8 *)c->src;
+	u8 *d = (u8 *)c->dst + (s64)y * c->dpitch + x;
+	s64 u = s->x, v = s->y;
+	const s64 du = s->dx, dv = s->dy;
+	const u16 sh = s->sh;
+	s32 i;
+	for (i = 0; i < n; i++)
+	{
+		FR_WARP_BILERP(u8)
+		u += du;
+		v += dv;
+	}
+}
+
+static void fr_warp_row16b(const fr_warp_ctx *c, const FR_Span2D *s, s32 x, s32 y, s32 n)
+{
+	const u16 *src = (const u16 *)c->src;
+	u16 *d = (u16 *)c->dst + (s64)y * c->dpitch + x;
+	s64 u = s->x, v = s->y;
+	const s64 du = s->dx, dv = s->dy;
+	const u16 sh = s->sh;
+	s32 i;
+	for (i = 0; i < n; i++)
+	{
+		FR_WARP_BILERP(u16)
+		u += du;
+		v += dv;
+	}
+}
+
+// destination rows y0..y1-1 in FR_WARP_TILE squares, one span per tile row
+static void fr_warp_tiles(FR_Matrix2D_CPT *inv, const fr_warp_ctx *c, fr_warp_row row,
+                          s32 dw, s32 y0, s32 y1, u16 r)
+{
+	s32 tx, ty, y;
+	for (ty = y0; ty < y1; ty += FR_WARP_TILE)
+	{
+		s32 ye = (y1 - ty > FR_WARP_TILE) ? ty + FR_WARP_TILE : y1;
+		for (tx = 0; tx < dw; tx += FR_WARP_TILE)
+		{
+			s32 n = (dw - tx > FR_WARP_TILE) ? FR_WARP_TILE : dw - tx;
+			for (y = ty; y < ye; y++)
+			{
+				FR_Span2D s;
+				inv->SpanI(&s, 2 * tx + 1, 2 * y + 1, 2, 0, 1, r);
+				row(c, &s, tx, y, n);
+			}
+		}
+	}
+}
+
+bool FR_Matrix2D_CPT ::Warp(const FR_Image8 *src, FR_Image8 *dst, int mode, u8 fill, s32 y0, s32 y1)
+{
+	FR_Matrix2D_CPT inv(FR_WARP_RADIX);
+	fr_warp_ctx c;
+	int bl = (mode == FR_WARP_BILINEAR);
+	if (!src || !dst || !src->p || !dst->p || src->w <= 0 || src->h <= 0 || src->pitch < src->w ||
+	    dst->w <= 0 || dst->h <= 0 || dst->pitch < dst->w || !fr_warp_inv(this, bl, &inv))
+		return false;
+	c.src = src->p;
+	c.dst = dst->p;
+	c.w = src->w;
+	c.h = src->h;
+	c.spitch = src->pitch;
+	c.dpitch = dst->pitch;
+	c.fill = fill;
+	y0 = (y0 < 0) ? 0 : y0;
+	y1 = (y1 > dst->h) ? dst->h : y1;
+	fr_warp_tiles(&inv, &c, bl ? fr_warp_row8b : fr_warp_row8n, dst->w, y0, y1,
+	              (u16)(bl ? FR_WARP_RADIX - FR_WARP_FRAC : FR_WARP_RADIX));
+	return true;
+}
+
+bool FR_Matrix2D_CPT ::Warp(const FR_Image16 *src, FR_Image16 *dst, int mode, u16 fill, s32 y0, s32 y1)
+{
+	FR_Matrix2D_CPT inv(FR_WARP_RADIX);
+	fr_warp_ctx c;
+	int bl = (mode == FR_WARP_BILINEAR);
+	if (!src || !dst || !src->p || !dst->p || src->w <= 0 || src->h <= 0 || src->pitch < src->w ||
+	    dst->w <= 0 || dst->h <= 0 || dst->pitch < dst->w || !fr_warp_inv(this, bl, &inv))
+		return false;
+	c.src = src->p;
+	c.dst = dst->p;
+	c.w = src->w;
+	c.h = src->h;
+	c.spitch = src->pitch;
+	c.dpitch = dst->pitch;
+	c.fill = fill;
+	y0 = (y0 < 0) ? 0 : y0;
+	y1 = (y1 > dst->h) ? dst->h : y1;
+	fr_warp_tiles(&inv, &c, bl ? fr_warp_row16b : fr_warp_row16n, dst->w, y0, y1,
+	              (u16)(bl ? FR_WARP_RADIX - FR_WARP_FRAC : FR_WARP_RADIX));
+	return true;
+}
 //} //end namespace FR_MATH
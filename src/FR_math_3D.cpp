@@ -0,0 +1,568 @@
+/**
+ *
+ *	@file FR_math_3D.cpp - c++ implementation file for fixed radix math
+ *                       - 3D affine / projective matrices
+ *
+ *	@copy Copyright (C) <2001-2026>  <M. A. Chatterjee>
+ *  @author M A Chatterjee <deftio [at] deftio [dot] com>
+ *	@version 2.0.8
+ *
+ *  This file contains integer math settable fixed point radix math routines for
+ *  use on systems in which floating point is not desired or unavailable.
+ *
+ *	This software is provided 'as-is', without any express or implied
+ *	warranty. In no event will the authors be held liable for any damages
+ *	arising from the use of this software.
+ *
+ *	Permission is granted to anyone to use this software for any purpose,
+ *	including commercial applications, and to alter it and redistribute it
+ *	freely, subject to the following restrictions:
+ *
+ *	1. The origin of this software must not be misrepresented; you must not
+ *	claim that you wrote the original software. If you use this software
+ *	in a product, please place an acknowledgment in the product documentation.
+ *
+ *	2. Altered source versions must be plainly marked as such, and must not be
+ *	misrepresented as being the original software.
+ *
+ *	3. This notice may not be removed or altered from any source
+ *	distribution.
+ *
+ */
+
+#include "FR_math_3D.h"
+#include "FR_math.h"
+#include "FR_simd_x86.h"   // FR_SIMD_X86_ACTIVE: AVX2 batch point transforms
+// namespace FR_MATH {
+//=======================================================
+//  Helpers
+//
+// The matrix is handled as s32 a[16], row by row, for the 4x4 products.
+// Sums of products are exact: each s32*s32 product is split into p >> 2
+// and p & 3 so that up to six of them add without leaving s64, and the
+// sum is rounded once to the target radix.
+
+static void fr_m3_get(const FR_Matrix3D *m, s32 *a)
+{
+	a[0] = m->m00;	a[1] = m->m01;	a[2] = m->m02;	a[3] = m->m03;
+	a[4] = m->m10;	a[5] = m->m11;	a[6] = m->m12;	a[7] = m->m13;
+	a[8] = m->m20;	a[9] = m->m21;	a[10] = m->m22;	a[11] = m->m23;
+	a[12] = m->m30;	a[13] = m->m31;	a[14] = m->m32;	a[15] = m->m33;
+}
+
+static void fr_m3_put(FR_Matrix3D *m, const s32 *a)
+{
+	m->m00 = a[0];	m->m01 = a[1];	m->m02 = a[2];	m->m03 = a[3];
+	m->m10 = a[4];	m->m11 = a[5];	m->m12 = a[6];	m->m13 = a[7];
+	m->m20 = a[8];	m->m21 = a[9];	m->m22 = a[10];	m->m23 = a[11];
+	m->m30 = a[12];	m->m31 = a[13];	m->m32 = a[14];	m->m33 = a[15];
+}
+
+static s32 fr_m3_sat(s64 v)
+{
+	if (v > (s64)FR_OVERFLOW_POS)
+		return FR_OVERFLOW_POS;
+	if (v < (s64)FR_OVERFLOW_NEG)
+		return FR_OVERFLOW_NEG;
+	return (s32)v;
+}
+
+// (p[0] + ... + p[n-1]) / 2^r rounded to nearest, n <= 6, each |p| <= 2^62.
+// For r < 3 a sum beyond 2^40 is clamped there (it saturates either way).
+static s64 fr_m3_sum(const s64 *p, int n, u16 r)
+{
+	s64 hi = 0, lo = 0;
+	const s64 lim = (s64)1 << 40;
+	int i;
+	for (i = 0; i < n; i++)
+	{
+		hi += p[i] >> 2;
+		lo += p[i] & 3;
+	}
+	hi += lo >> 2; // sum = 4*hi + lo, 0 <= lo < 4
+	lo &= 3;
+	if (r >= 3)
+		return (hi + ((s64)1 << (r - 3))) >> (r - 2);
+	hi = (hi > lim) ? lim : ((hi < -lim) ? -lim : hi);
+	if (r == 2)
+		return hi + (lo >= 2);
+	if (r == 1)
+		return 2 * hi + ((lo + 1) >> 1);
+	return 4 * hi + lo;
+}
+
+// a*b - c*d at radix r (inputs at radix r), saturated to +-FR_OVERFLOW_POS
+// so that the result can be negated
+static s32 fr_m3_det2(s32 a, s32 b, s32 c, s32 d, u16 r)
+{
+	s64 p[2];
+	s32 v;
+	p[0] = (s64)a * b;
+	p[1] = -((s64)c * d);
+	v = fr_m3_sat(fr_m3_sum(p, 2, r));
+	return (v == FR_OVERFLOW_NEG) ? -FR_OVERFLOW_POS : v;
+}
+
+// a0*b0 + a1*b1 + a2*b2 at radix r, saturated
+static s32 fr_m3_dot3(s32 a0, s32 b0, s32 a1, s32 b1, s32 a2, s32 b2, u16 r)
+{
+	s64 p[3];
+	p[0] = (s64)a0 * b0;
+	p[1] = (s64)a1 * b1;
+	p[2] = (s64)a2 * b2;
+	return fr_m3_sat(fr_m3_sum(p, 3, r));
+}
+
+// num / den rounded to nearest (half away from zero, as FR_DIV), saturated
+static s32 fr_m3_div(s64 num, s64 den)
+{
+	if ((num ^ den) >= 0)
+		return fr_m3_sat((num + den / 2) / den);
+	return fr_m3_sat((num - den / 2) / den);
+}
+
+// perspective divide shared by the scalar and batch forms
+static int fr_m3_divw(s32 X, s32 Y, s32 Z, s32 W, u16 r, s32 *xp, s32 *yp, s32 *zp)
+{
+	s64 k = (s64)1 << r;
+	if (W <= 0)
+	{
+		*xp = *yp = *zp = FR_OVERFLOW_NEG;
+		return 0;
+	}
+	*xp = fr_m3_div(X * k, W);
+	*yp = fr_m3_div(Y * k, W);
+	*zp = fr_m3_div(Z * k, W);
+	return 1;
+}
+
+// s1.30 trig value to radix r (0..30), rounded
+static s32 fr_m3_trig(s32 v, u16 r)
+{
+	if (r >= 30)
+		return v;
+	return (v + ((s32)1 << (29 - r))) >> (30 - r);
+}
+
+//=======================================================
+//  Matrix Functions
+
+void FR_Matrix3D::ID()
+{
+	s32 a[16] = {0};
+	a[0] = a[5] = a[10] = a[15] = I2FR(1, radix);
+	fr_m3_put(this, a);
+	checkfast();
+}
+
+void FR_Matrix3D::set(const s32 *a, u16 nRadix)
+{
+	s32 b[16];
+	int i;
+	if (!a)
+		return;
+	for (i = 0; i < 12; i++)
+		b[i] = a[i];
+	b[12] = b[13] = b[14] = 0;
+	b[15] = I2FR(1, nRadix);
+	fr_m3_put(this, b);
+	radix = nRadix;
+	checkfast();
+}
+
+void FR_Matrix3D::set4x4(const s32 *a, u16 nRadix)
+{
+	if (!a)
+		return;
+	fr_m3_put(this, a);
+	radix = nRadix;
+	checkfast();
+}
+
+//================================================================
+// det() and inv() use the 2x2 sub-determinants of the top two rows (s0..s5)
+// and the bottom two rows (c0..c5); each is rounded to radix, then every
+// cofactor and the determinant are rounded once more.  Affine matrices
+// get their bottom row back as exactly 0 0 0 1.
+
+static s64 fr_m3_inv_parts(const s32 *a, u16 r, s32 *s, s32 *c)
+{
+	s64 p[6];
+	s[0] = fr_m3_det2(a[0], a[5], a[4], a[1], r);
+	s[1] = fr_m3_det2(a[0], a[6], a[4], a[2], r);
+	s[2] = fr_m3_det2(a[0], a[7], a[4], a[3], r);
+	s[3] = fr_m3_det2(a[1], a[6], a[5], a[2], r);
+	s[4] = fr_m3_det2(a[1], a[7], a[5], a[3], r);
+	s[5] = fr_m3_det2(a[2], a[7], a[6], a[3], r);
+	c[5] = fr_m3_det2(a[10], a[15], a[14], a[11], r);
+	c[4] = fr_m3_det2(a[9], a[15], a[13], a[11], r);
+	c[3] = fr_m3_det2(a[9], a[14], a[13], a[10], r);
+	c[2] = fr_m3_det2(a[8], a[15], a[12], a[11], r);
+	c[1] = fr_m3_det2(a[8], a[14], a[12], a[10], r);
+	c[0] = fr_m3_det2(a[8], a[13], a[12], a[9], r);
+	p[0] = (s64)s[0] * c[5];
+	p[1] = -((s64)s[1] * c[4]);
+	p[2] = (s64)s[2] * c[3];
+	p[3] = (s64)s[3] * c[2];
+	p[4] = -((s64)s[4] * c[1]);
+	p[5] = (s64)s[5] * c[0];
+	return fr_m3_sum(p, 6, r);
+}
+
+s32 FR_Matrix3D::det()
+{
+	s32 a[16], s[6], c[6];
+	fr_m3_get(this, a);
+	return fr_m3_sat(fr_m3_inv_parts(a, radix, s, c));
+}
+
+bool FR_Matrix3D::inv(FR_Matrix3D *npI)
+{
+	s32 a[16], s[6], c[6], cof[16], b[16];
+	s64 d, k = (s64)1 << radix;
+	u16 r = radix;
+	int i;
+
+	if (!npI || npI == this)
+		return false;
+	fr_m3_get(this, a);
+	d = fr_m3_inv_parts(a, r, s, c);
+	if (0 == d)
+		return false;
+
+	// cofactor signs are carried on the sub-determinants
+	cof[0] = fr_m3_dot3(a[5], c[5], a[6], -c[4], a[7], c[3], r);
+	cof[1] = fr_m3_dot3(a[1], -c[5], a[2], c[4], a[3], -c[3], r);
+	cof[2] = fr_m3_dot3(a[13], s[5], a[14], -s[4], a[15], s[3], r);
+	cof[3] = fr_m3_dot3(a[9], -s[5], a[10], s[4], a[11], -s[3], r);
+	cof[4] = fr_m3_dot3(a[4], -c[5], a[6], c[2], a[7], -c[1], r);
+	cof[5] = fr_m3_dot3(a[0], c[5], a[2], -c[2], a[3], c[1], r);
+	cof[6] = fr_m3_dot3(a[12], -s[5], a[14], s[2], a[15], -s[1], r);
+	cof[7] = fr_m3_dot3(a[8], s[5], a[10], -s[2], a[11], s[1], r);
+	cof[8] = fr_m3_dot3(a[4], c[4], a[5], -c[2], a[7], c[0], r);
+	cof[9] = fr_m3_dot3(a[0], -c[4], a[1], c[2], a[3], -c[0], r);
+	cof[10] = fr_m3_dot3(a[12], s[4], a[13], -s[2], a[15], s[0], r);
+	cof[11] = fr_m3_dot3(a[8], -s[4], a[9], s[2], a[11], -s[0], r);
+	cof[12] = fr_m3_dot3(a[4], -c[3], a[5], c[1], a[6], -c[0], r);
+	cof[13] = fr_m3_dot3(a[0], c[3], a[1], -c[1], a[2], c[0], r);
+	cof[14] = fr_m3_dot3(a[12], -s[3], a[13], s[1], a[14], -s[0], r);
+	cof[15] = fr_m3_dot3(a[8], s[3], a[9], -s[1], a[10], s[0], r);
+
+	for (i = 0; i < 16; i++)
+		b[i] = fr_m3_div(cof[i] * k, d);
+	if (!proj)
+	{
+		b[12] = b[13] = b[14] = 0;
+		b[15] = I2FR(1, r);
+	}
+	npI->radix = r;
+	fr_m3_put(npI, b);
+	npI->checkfast();
+	return true;
+}
+
+bool FR_Matrix3D::inv()
+{
+	FR_Matrix3D n;
+	if (!inv(&n))
+		return false;
+	*this = n;
+	return true;
+}
+
+//=======================================================
+// Compose this = this * pMul: transforming a point by the result is the
+// same as transforming it by pMul and then by this.  pMul may be at a
+// different radix (0..31); the result keeps this->radix.  Each element is
+// an exact 64-bit sum rounded once from radix + pMul->radix and saturated.
+// pMul may be this.
+
+void FR_Matrix3D::mul(const FR_Matrix3D *pMul)
+{
+	s32 a[16], b[16], o[16];
+	s64 p[4];
+	int i, j, k;
+	fr_m3_get(this, a);
+	fr_m3_get(pMul, b);
+	for (i = 0; i < 4; i++)
+	{
+		for (j = 0; j < 4; j++)
+		{
+			for (k = 0; k < 4; k++)
+				p[k] = (s64)a[4 * i + k] * b[4 * k + j];
+			o[4 * i + j] = fr_m3_sat(fr_m3_sum(p, 4, pMul->radix));
+		}
+	}
+	fr_m3_put(this, o);
+	checkfast();
+}
+
+//================================================================
+// rotations about one axis, angle in BAM, from the s1.30 fr_sincos_bam32
+void FR_Matrix3D::setrotateX(u16 bam)
+{
+	s32 s, c, one = I2FR(1, radix);
+	fr_sincos_bam32(FR_BAM2PHASE32(bam), &s, &c);
+	s = fr_m3_trig(s, radix);
+	c = fr_m3_trig(c, radix);
+	m00 = one;	m01 = 0;	m02 = 0;
+	m10 = 0;	m11 = c;	m12 = -s;
+	m20 = 0;	m21 = s;	m22 = c;
+	checkfast();
+}
+
+void FR_Matrix3D::setrotateY(u16 bam)
+{
+	s32 s, c, one = I2FR(1, radix);
+	fr_sincos_bam32(FR_BAM2PHASE32(bam), &s, &c);
+	s = fr_m3_trig(s, radix);
+	c = fr_m3_trig(c, radix);
+	m00 = c;	m01 = 0;	m02 = s;
+	m10 = 0;	m11 = one;	m12 = 0;
+	m20 = -s;	m21 = 0;	m22 = c;
+	checkfast();
+}
+
+void FR_Matrix3D::setrotateZ(u16 bam)
+{
+	s32 s, c, one = I2FR(1, radix);
+	fr_sincos_bam32(FR_BAM2PHASE32(bam), &s, &c);
+	s = fr_m3_trig(s, radix);
+	c = fr_m3_trig(c, radix);
+	m00 = c;	m01 = -s;	m02 = 0;
+	m10 = s;	m11 = c;	m12 = 0;
+	m20 = 0;	m21 = 0;	m22 = one;
+	checkfast();
+}
+
+// Rz * Ry * Rx: a point is rotated about X first, then Y, then Z
+void FR_Matrix3D::setrotate(u16 bamx, u16 bamy, u16 bamz)
+{
+	FR_Matrix3D t(radix);
+	setrotateZ(bamz);
+	t.setrotateY(bamy);
+	mul(&t);
+	t.setrotateX(bamx);
+	mul(&t);
+}
+
+void FR_Matrix3D::setperspective(s32 d)
+{
+	m30 = 0;
+	m31 = 0;
+	m32 = d ? fr_m3_div((s64)1 << radix, d) : 0;
+	m33 = I2FR(1, radix);
+	checkfast();
+}
+
+//=======================================================
+// standard matrix operators
+
+FR_Matrix3D &FR_Matrix3D::operator*=(const FR_Matrix3D &nM)
+{
+	mul(&nM);
+	return *this;
+}
+
+FR_Matrix3D &FR_Matrix3D::operator=(const FR_Matrix3D &nM)
+{
+	s32 a[16];
+	fr_m3_get(&nM, a);
+	fr_m3_put(this, a);
+	radix = nM.radix;
+	checkfast();
+	return *this;
+}
+
+bool FR_Matrix3D::XFormPtIProj(s32 x, s32 y, s32 z, s32 *xp, s32 *yp, s32 *zp, u16 r)
+{
+	return fr_m3_divw(row(x, y, z, m00, m01, m02, m03), row(x, y, z, m10, m11, m12, m13),
+	                  row(x, y, z, m20, m21, m22, m23), row(x, y, z, m30, m31, m32, m33),
+	                  r, xp, yp, zp) != 0;
+}
+
+//=======================================================
+// Batch point transforms
+//
+// Same arithmetic as the scalar forms: each row is x*a + y*b + z*c + t
+// wrapping in 32 bits, then an arithmetic shift (affine) or the rounded
+// divide by w (projective).  The AVX2 kernels take 8 points per step with
+// mullo_epi32.  The perspective divide is done in double precision, as
+// the tangent kernels in FR_math.c do it: for r <= 21 the numerator
+// X*2^r +- floor(w/2) is an integer below 2^53, so the correctly rounded
+// double quotient truncates to the same integer as the s64 divide in
+// fr_m3_div.  Larger r is left to the scalar loop.
+
+#ifdef FR_SIMD_X86_ACTIVE
+// x*a + y*b + z*c + t on 8 lanes (y, z unused in fast mode)
+__attribute__((target("avx2")))
+static inline __m256i fr_row8_avx2(__m256i x, __m256i y, __m256i z, const __m256i *k, int fast)
+{
+	__m256i v = _mm256_add_epi32(_mm256_mullo_epi32(x, k[0]), k[3]);
+	if (!fast)
+	{
+		v = _mm256_add_epi32(v, _mm256_mullo_epi32(y, k[1]));
+		v = _mm256_add_epi32(v, _mm256_mullo_epi32(z, k[2]));
+	}
+	return v;
+}
+
+// k[4*i + j] = broadcast of row i, column j
+__attribute__((target("avx2")))
+static void fr_m3_coef_avx2(const FR_Matrix3D *m, __m256i *k)
+{
+	s32 a[16];
+	int i;
+	fr_m3_get(m, a);
+	for (i = 0; i < 16; i++)
+		k[i] = _mm256_set1_epi32(a[i]);
+}
+
+__attribute__((target("avx2")))
+static u32 fr_xf3pts_avx2(const FR_Matrix3D *m, const s32 *xs, const s32 *ys, const s32 *zs,
+                          s32 *xps, s32 *yps, s32 *zps, u32 n, u16 r)
+{
+	__m256i k[16];
+	__m128i sh = _mm_cvtsi32_si128(r);
+	int fast = m->fast;
+	u32 i = 0;
+	fr_m3_coef_avx2(m, k);
+	for (; i + 8 <= n; i += 8)
+	{
+		__m256i x = _mm256_loadu_si256((const __m256i *)(const void *)(xs + i));
+		__m256i y = _mm256_loadu_si256((const __m256i *)(const void *)(ys + i));
+		__m256i z = _mm256_loadu_si256((const __m256i *)(const void *)(zs + i));
+		__m256i xp, yp, zp;
+		if (fast)
+		{
+			xp = fr_row8_avx2(x, y, z, k, 1);
+			yp = _mm256_add_epi32(_mm256_mullo_epi32(y, k[5]), k[7]);
+			zp = _mm256_add_epi32(_mm256_mullo_epi32(z, k[10]), k[11]);
+		}
+		else
+		{
+			xp = fr_row8_avx2(x, y, z, k, 0);
+			yp = fr_row8_avx2(x, y, z, k + 4, 0);
+			zp = fr_row8_avx2(x, y, z, k + 8, 0);
+		}
+		_mm256_storeu_si256((__m256i *)(void *)(xps + i), _mm256_sra_epi32(xp, sh));
+		_mm256_storeu_si256((__m256i *)(void *)(yps + i), _mm256_sra_epi32(yp, sh));
+		_mm256_storeu_si256((__m256i *)(void *)(zps + i), _mm256_sra_epi32(zp, sh));
+	}
+	return i;
+}
+
+// round(v * 2^r / w) on 4 lanes, saturated; w > 0, hw = floor(w / 2)
+__attribute__((target("avx2")))
+static inline __m128i fr_pdiv4_avx2(__m128i v, __m256d w, __m256d hw, __m256d kr)
+{
+	const __m256d lo = _mm256_set1_pd(-2147483648.0), hi = _mm256_set1_pd(2147483647.0);
+	const __m256d sgn = _mm256_set1_pd(-0.0);
+	__m256d num = _mm256_mul_pd(_mm256_cvtepi32_pd(v), kr);
+	num = _mm256_add_pd(num, _mm256_or_pd(hw, _mm256_and_pd(num, sgn)));
+	num = _mm256_min_pd(_mm256_max_pd(_mm256_div_pd(num, w), lo), hi);
+	return _mm256_cvttpd_epi32(num);
+}
+
+__attribute__((target("avx2")))
+static inline __m256i fr_pdiv8_avx2(__m256i v, const __m256d *w, const __m256d *hw, __m256d kr)
+{
+	__m128i a = fr_pdiv4_avx2(_mm256_castsi256_si128(v), w[0], hw[0], kr);
+	__m128i b = fr_pdiv4_avx2(_mm256_extracti128_si256(v, 1), w[1], hw[1], kr);
+	return _mm256_inserti128_si256(_mm256_castsi128_si256(a), b, 1);
+}
+
+__attribute__((target("avx2")))
+static u32 fr_xf3proj_avx2(const FR_Matrix3D *m, const s32 *xs, const s32 *ys, const s32 *zs,
+                           s32 *xps, s32 *yps, s32 *zps, u32 n, u16 r, u32 *clip)
+{
+	__m256i k[16];
+	const __m256i one = _mm256_set1_epi32(1), bad = _mm256_set1_epi32(FR_OVERFLOW_NEG);
+	const __m256d kr = _mm256_set1_pd((double)((s64)1 << (r > 21 ? 0 : r)));
+	u32 i = 0;
+	if (r > 21)
+		return 0;
+	fr_m3_coef_avx2(m, k);
+	for (; i + 8 <= n; i += 8)
+	{
+		__m256i x = _mm256_loadu_si256((const __m256i *)(const void *)(xs + i));
+		__m256i y = _mm256_loadu_si256((const __m256i *)(const void *)(ys + i));
+		__m256i z = _mm256_loadu_si256((const __m256i *)(const void *)(zs + i));
+		__m256i X = fr_row8_avx2(x, y, z, k, 0);
+		__m256i Y = fr_row8_avx2(x, y, z, k + 4, 0);
+		__m256i Z = fr_row8_avx2(x, y, z, k + 8, 0);
+		__m256i W = fr_row8_avx2(x, y, z, k + 12, 0);
+		__m256i ok = _mm256_cmpgt_epi32(W, _mm256_setzero_si256());
+		__m256i w1 = _mm256_blendv_epi8(one, W, ok), hw1 = _mm256_srli_epi32(w1, 1);
+		__m256d w[2], hw[2];
+		w[0] = _mm256_cvtepi32_pd(_mm256_castsi256_si128(w1));
+		w[1] = _mm256_cvtepi32_pd(_mm256_extracti128_si256(w1, 1));
+		hw[0] = _mm256_cvtepi32_pd(_mm256_castsi256_si128(hw1));
+		hw[1] = _mm256_cvtepi32_pd(_mm256_extracti128_si256(hw1, 1));
+		_mm256_storeu_si256((__m256i *)(void *)(xps + i), _mm256_blendv_epi8(bad, fr_pdiv8_avx2(X, w, hw, kr), ok));
+		_mm256_storeu_si256((__m256i *)(void *)(yps + i), _mm256_blendv_epi8(bad, fr_pdiv8_avx2(Y, w, hw, kr), ok));
+		_mm256_storeu_si256((__m256i *)(void *)(zps + i), _mm256_blendv_epi8(bad, fr_pdiv8_avx2(Z, w, hw, kr), ok));
+		*clip += 8u - (u32)__builtin_popcount((unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(ok)));
+	}
+	return i;
+}
+#endif
+
+void FR_Matrix3D::XFormPtsI(const s32 *xs, const s32 *ys, const s32 *zs,
+                            s32 *xps, s32 *yps, s32 *zps, u32 n, u16 r)
+{
+	u32 i = 0;
+	s32 a[16];
+	if (!xs || !ys || !zs || !xps || !yps || !zps)
+		return;
+	fr_m3_get(this, a);
+#ifdef FR_SIMD_X86_ACTIVE
+	if (fr_simd_x86_level() >= FR_SIMD_AVX2)
+		i = fr_xf3pts_avx2(this, xs, ys, zs, xps, yps, zps, n, r);
+#endif
+	if (fast)
+	{
+		for (; i < n; i++)
+		{
+			s32 x = xs[i], y = ys[i], z = zs[i];
+			xps[i] = row(x, 0, 0, a[0], 0, 0, a[3]) >> r;
+			yps[i] = row(y, 0, 0, a[5], 0, 0, a[7]) >> r;
+			zps[i] = row(z, 0, 0, a[10], 0, 0, a[11]) >> r;
+		}
+	}
+	else
+	{
+		for (; i < n; i++)
+		{
+			s32 x = xs[i], y = ys[i], z = zs[i];
+			xps[i] = row(x, y, z, a[0], a[1], a[2], a[3]) >> r;
+			yps[i] = row(x, y, z, a[4], a[5], a[6], a[7]) >> r;
+			zps[i] = row(x, y, z, a[8], a[9], a[10], a[11]) >> r;
+		}
+	}
+}
+
+u32 FR_Matrix3D::XFormPtsIProj(const s32 *xs, const s32 *ys, const s32 *zs,
+                               s32 *xps, s32 *yps, s32 *zps, u32 n, u16 r)
+{
+	u32 i = 0, clip = 0;
+	s32 a[16];
+	if (!xs || !ys || !zs || !xps || !yps || !zps)
+		return 0;
+	fr_m3_get(this, a);
+#ifdef FR_SIMD_X86_ACTIVE
+	if (fr_simd_x86_level() >= FR_SIMD_AVX2)
+		i = fr_xf3proj_avx2(this, xs, ys, zs, xps, yps, zps, n, r, &clip);
+#endif
+	for (; i < n; i++)
+	{
+		s32 x = xs[i], y = ys[i], z = zs[i];
+		clip += (u32)!fr_m3_divw(row(x, y, z, a[0], a[1], a[2], a[3]),
+		                         row(x, y, z, a[4], a[5], a[6], a[7]),
+		                         row(x, y, z, a[8], a[9], a[10], a[11]),
+		                         row(x, y, z, a[12], a[13], a[14], a[15]),
+		                         r, xps + i, yps + i, zps + i);
+	}
+	return clip;
+}
+//} //end namespace FR_MATH
@@ -0,0 +1,203 @@
+/**
+ *	@file FR_math_3D.h - header definition file for fixed radix 3D coordinate transforms
+ *
+ *	@copy Copyright (C) <2001-2026>  <M. A. Chatterjee>
+ *  @author M A Chatterjee <deftio [at] deftio [dot] com>
+ *	@version 2.0.8
+ *
+ *  This file contains integer math settable fixed point radix math routines for
+ *  use on systems in which floating point is not desired or unavailable.
+ *  FR_Matrix3D holds a 3x4 affine or 4x4 projective transform and follows
+ *  the same design as FR_Matrix2D_CPT in FR_math_2D.h.
+ *
+ *  @license:
+ *	This software is provided 'as-is', without any express or implied
+ *	warranty. In no event will the authors be held liable for any damages
+ *	arising from the use of this software.
+ *
+ *	Permission is granted to anyone to use this software for any purpose,
+ *	including commercial applications, and to alter it and redistribute it
+ *	freely, subject to the following restrictions:
+ *
+ *	1. The origin of this software must not be misrepresented; you must not
+ *	claim that you wrote the original software. If you use this software
+ *	in a product, an acknowledgment in the product documentation would be
+ *	appreciated but is not required.
+ *
+ *	2. Altered source versions must be plainly marked as such, and must not be
+ *	misrepresented as being the original software.
+ *
+ *	3. This notice may not be removed or altered from any source
+ *	distribution.
+ *
+ */
+
+#ifndef __FR_math_3D_h__
+#define __FR_math_3D_h__
+
+#ifdef __cplusplus
+// namespace  FR_MATH {
+extern "C"
+{
+#endif
+
+#ifndef __FR_Platform_Defs_H__
+#include "FR_defs.h"
+#endif
+
+#ifndef __FR_Math_h__
+#include "FR_math.h"
+#endif
+
+//===============================================
+// 3D Fixed radix matrix class for coordinate point transforms
+// A 4x4 matrix at a settable radix.  Affine matrices keep the bottom row at
+// 0 0 0 1 and use only the top three rows (3x4); a projective matrix
+// (e.g. from setperspective()) has a general bottom row, and XFormPtIProj()
+// divides by the resulting w.
+//================================================
+#ifndef FR_MAT_DEFPREC
+#define FR_MAT_DEFPREC (8) // default precision radix
+#endif
+
+	struct FR_Matrix3D
+	{
+		// note: if modifying these variables by hand be sure to call checkfast() afterwards
+		s32 m00, m01, m02, m03;
+		s32 m10, m11, m12, m13;
+		s32 m20, m21, m22, m23;
+		s32 m30, m31, m32, m33; // 0 0 0 1 (1 at radix) for affine matrices
+
+		u16 radix; // internal precision radix point
+		int fast;  // upper-left 3x3 is diagonal (scale / translate only)
+		int proj;  // bottom row is not 0 0 0 1
+
+		//========================
+		void ID(); // create Identity matrix
+
+		//=======================
+		FR_Matrix3D(u16 nRadix = FR_MAT_DEFPREC) : radix(nRadix) { ID(); }; // constructor
+
+		// matrix operators
+		s32 det();							// determinant at radix (4x4, equal to the 3x3 for affine)
+		bool inv(FR_Matrix3D *nInv);		// inverse into nInv; returns false if singular or aliased
+		bool inv();							// inverse of this in place; returns false if singular
+		void mul(const FR_Matrix3D *pMul);	// matrix this = this*pMul (pMul applied first), see .cpp
+
+		// rotations overwrite the upper left 3x3 and keep the translation.
+		// angles are BAM (65536 per turn); valid for radix 0..30
+		void setrotateX(u16 bam);
+		void setrotateY(u16 bam);
+		void setrotateZ(u16 bam);
+		void setrotate(u16 bamx, u16 bamy, u16 bamz); // X first, then Y, then Z
+		// bottom row 0 0 1/d 1: eye at z = -d looking toward +z, the z = 0
+		// plane keeps its scale.  d == 0 restores 0 0 0 1.
+		void setperspective(s32 d);
+
+		FR_Matrix3D &operator=(const FR_Matrix3D &nM);
+		FR_Matrix3D &operator*=(const FR_Matrix3D &nM);
+
+		bool checkfast()
+		{
+			fast = ((m01 == 0) && (m02 == 0) && (m10 == 0) && (m12 == 0) && (m20 == 0) && (m21 == 0)) ? true : false;
+			proj = ((m30 != 0) || (m31 != 0) || (m32 != 0) || (m33 != I2FR(1, radix))) ? true : false;
+			return fast;
+		};
+		// a is 12 values row by row (3x4 affine) or 16 values (4x4)
+		void set(const s32 *a, u16 nRadix = FR_MAT_DEFPREC);
+		void set4x4(const s32 *a, u16 nRadix = FR_MAT_DEFPREC);
+
+		// coordinate transform fns
+		void XlateI(s32 x, s32 y, s32 z)
+		{
+			m03 = (s32)((u32)x << radix);
+			m13 = (s32)((u32)y << radix);
+			m23 = (s32)((u32)z << radix);
+		}
+		void XlateI(s32 x, s32 y, s32 z, u16 nRadix)
+		{
+			m03 = (s32)((u32)x << nRadix);
+			m13 = (s32)((u32)y << nRadix);
+			m23 = (s32)((u32)z << nRadix);
+		}
+		void XlateRelativeI(s32 x, s32 y, s32 z)
+		{
+			m03 += (s32)((u32)x << radix);
+			m13 += (s32)((u32)y << radix);
+			m23 += (s32)((u32)z << radix);
+		}
+
+		//========================
+		// x*a + y*b + z*c + t with 32-bit wraparound, as XFormPtI in FR_math_2D.h
+		static s32 row(s32 x, s32 y, s32 z, s32 a, s32 b, s32 c, s32 t)
+		{
+			return (s32)((u32)x * (u32)a + (u32)y * (u32)b + (u32)z * (u32)c + (u32)t);
+		}
+
+		// XFormPtI takes Integer input and produces fixed pt output (affine part only,
+		// the bottom row is ignored).  For integer results use r = radix.
+		void inline XFormPtI(s32 x, s32 y, s32 z, s32 *xp, s32 *yp, s32 *zp, u16 r)
+		{
+			if (fast)
+			{
+				*xp = row(x, 0, 0, m00, 0, 0, m03) >> r;
+				*yp = row(y, 0, 0, m11, 0, 0, m13) >> r;
+				*zp = row(z, 0, 0, m22, 0, 0, m23) >> r;
+			}
+			else
+			{
+				*xp = row(x, y, z, m00, m01, m02, m03) >> r;
+				*yp = row(x, y, z, m10, m11, m12, m13) >> r;
+				*zp = row(x, y, z, m20, m21, m22, m23) >> r;
+			}
+		}
+		void inline XFormPtI(s32 x, s32 y, s32 z, s32 *xp, s32 *yp, s32 *zp)
+		{
+			XFormPtI(x, y, z, xp, yp, zp, radix);
+		}
+		// take a point (vector) and XForm it w/o translation
+		void inline XFormPtINoTranslate(s32 x, s32 y, s32 z, s32 *xp, s32 *yp, s32 *zp, u16 r)
+		{
+			if (fast)
+			{
+				*xp = row(x, 0, 0, m00, 0, 0, 0) >> r;
+				*yp = row(y, 0, 0, m11, 0, 0, 0) >> r;
+				*zp = row(z, 0, 0, m22, 0, 0, 0) >> r;
+			}
+			else
+			{
+				*xp = row(x, y, z, m00, m01, m02, 0) >> r;
+				*yp = row(x, y, z, m10, m11, m12, 0) >> r;
+				*zp = row(x, y, z, m20, m21, m22, 0) >> r;
+			}
+		}
+
+		// full 4x4 transform with perspective divide: X, Y, Z, W from the four
+		// rows (32-bit wraparound as above), then X/W, Y/W, Z/W at radix r,
+		// rounded as FR_DIV.  w <= 0 (at or behind the eye) writes
+		// FR_OVERFLOW_NEG to all three outputs and returns false.
+		bool XFormPtIProj(s32 x, s32 y, s32 z, s32 *xp, s32 *yp, s32 *zp, u16 r);
+
+		//========================
+		// XFormPtsI / XFormPtsIProj transform n points held in planar arrays,
+		// point for point the same as XFormPtI / XFormPtIProj.  With FR_SIMD_X86
+		// both run 8 points per AVX2 step (the perspective divide for r <= 21).
+		// Outputs may overwrite the inputs; NULL pointers are a no-op.
+		// XFormPtsIProj returns the number of points with w <= 0.
+		void XFormPtsI(const s32 *xs, const s32 *ys, const s32 *zs,
+		               s32 *xps, s32 *yps, s32 *zps, u32 n, u16 r);
+		void XFormPtsI(const s32 *xs, const s32 *ys, const s32 *zs,
+		               s32 *xps, s32 *yps, s32 *zps, u32 n)
+		{
+			XFormPtsI(xs, ys, zs, xps, yps, zps, n, radix);
+		}
+		u32 XFormPtsIProj(const s32 *xs, const s32 *ys, const s32 *zs,
+		                  s32 *xps, s32 *yps, s32 *zps, u32 n, u16 r);
+	};
+
+#ifdef __cplusplus
+} // extern "C"
+//} // name space
+#endif
+
+#endif /* __FR_math_3D_h__ */
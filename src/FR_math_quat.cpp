@@ -0,0 +1,482 @@
+/**
+ *
+ *	@file FR_math_quat.cpp - c++ implementation file for fixed radix math
+ *                         - quaternions (s1.30)
+ *
+ *	@copy Copyright (C) <2001-2026>  <M. A. Chatterjee>
+ *  @author M A Chatterjee <deftio [at] deftio [dot] com>
+ *	@version 2.0.8
+ *
+ *  This file contains integer math settable fixed point radix math routines for
+ *  use on systems in which floating point is not desired or unavailable.
+ *
+ *	This software is provided 'as-is', without any express or implied
+ *	warranty. In no event will the authors be held liable for any damages
+ *	arising from the use of this software.
+ *
+ *	Permission is granted to anyone to use this software for any purpose,
+ *	including commercial applications, and to alter it and redistribute it
+ *	freely, subject to the following restrictions:
+ *
+ *	1. The origin of this software must not be misrepresented; you must not
+ *	claim that you wrote the original software. If you use this software
+ *	in a product, please place an acknowledgment in the product documentation.
+ *
+ *	2. Altered source versions must be plainly marked as such, and must not be
+ *	misrepresented as being the original software.
+ *
+ *	3. This notice may not be removed or altered from any source
+ *	distribution.
+ *
+ */
+
+#include "FR_math_quat.h"
+#include "FR_math.h"
+// namespace FR_MATH {
+//=======================================================
+//  Helpers
+
+// slerp switches to nlerp above this |a.b| (about 0.011 rad apart): the
+// s1.30 sines lose relative precision faster than nlerp loses linearity
+#define FR_QUAT_NLERP_DOT (FR_QUAT_ONE - ((s32)1 << 16))
+
+static s32 fr_q_sat(s64 v)
+{
+	if (v > (s64)FR_OVERFLOW_POS)
+		return FR_OVERFLOW_POS;
+	if (v < (s64)FR_OVERFLOW_NEG)
+		return FR_OVERFLOW_NEG;
+	return (s32)v;
+}
+
+// (p[0] + ... + p[n-1]) / 2^30 rounded to nearest and saturated, n <= 4,
+// each |p| <= 2^62.  Each product is split into p >> 2 and p & 3 so that
+// the sum stays in s64 (as fr_m3_sum in FR_math_3D.cpp).
+static s32 fr_q_sum(const s64 *p, int n)
+{
+	s64 hi = 0, lo = 0;
+	int i;
+	for (i = 0; i < n; i++)
+	{
+		hi += p[i] >> 2;
+		lo += p[i] & 3;
+	}
+	hi += lo >> 2;
+	return fr_q_sat((hi + ((s64)1 << 27)) >> 28);
+}
+
+// num / den rounded to nearest (half away from zero, as FR_DIV), den > 0
+static s32 fr_q_div(s64 num, s32 den)
+{
+	if (num >= 0)
+		return fr_q_sat((num + den / 2) / den);
+	return fr_q_sat((num - den / 2) / den);
+}
+
+static int fr_q_msb64(u64 v)
+{
+	int b = 0;
+	if (v >> 32) { v >>= 32; b += 32; }
+	if (v >> 16) { v >>= 16; b += 16; }
+	if (v >> 8)  { v >>= 8;  b += 8;  }
+	if (v >> 4)  { v >>= 4;  b += 4;  }
+	if (v >> 2)  { v >>= 2;  b += 2;  }
+	return b + (int)(v >> 1);
+}
+
+// matrix element at radix r (0..30) to s2.28, clamped to +-2
+static s32 fr_q_r28(s32 v, u16 r)
+{
+	const s64 lim = (s64)1 << 29;
+	s64 a;
+	if (r >= 28)
+		a = ((s64)v + (((s64)1 << (r - 28)) >> 1)) >> (r - 28);
+	else
+		a = (s64)v * ((s64)1 << (28 - r));
+	return (s32)((a > lim) ? lim : ((a < -lim) ? -lim : a));
+}
+
+// 2 * (p / 2^60) at radix r (0..30), p an s64 product sum halved on entry
+static s32 fr_q_elem(s64 ph, u16 r)
+{
+	return fr_q_sat((ph + ((s64)1 << (57 - r))) >> (58 - r));
+}
+
+//================================================================
+// rotation matrix <-> quaternion on a 3x3 held as s32 a[9], row by row
+
+static void fr_q_to3x3(const FR_Quat *q, u16 r, s32 *a)
+{
+	s64 w = q->w, x = q->x, y = q->y, z = q->z;
+	s64 xx = (x * x) >> 1, yy = (y * y) >> 1, zz = (z * z) >> 1;
+	s64 xy = (x * y) >> 1, xz = (x * z) >> 1, yz = (y * z) >> 1;
+	s64 wx = (w * x) >> 1, wy = (w * y) >> 1, wz = (w * z) >> 1;
+	s32 one = I2FR(1, r);
+	a[0] = fr_q_sat((s64)one - fr_q_elem(yy + zz, r));
+	a[1] = fr_q_elem(xy - wz, r);
+	a[2] = fr_q_elem(xz + wy, r);
+	a[3] = fr_q_elem(xy + wz, r);
+	a[4] = fr_q_sat((s64)one - fr_q_elem(xx + zz, r));
+	a[5] = fr_q_elem(yz - wx, r);
+	a[6] = fr_q_elem(xz - wy, r);
+	a[7] = fr_q_elem(yz + wx, r);
+	a[8] = fr_q_sat((s64)one - fr_q_elem(xx + yy, r));
+}
+
+// Shepperd's method: the largest of w, x, y, z comes from 1 + trace (or
+// 1 + one diagonal - the other two) = u, the rest from sums / differences
+// of the off-diagonal pairs.  With g = 1/sqrt(u) from FR_rsqrt the big
+// component is u*g/2 and the others (pair)*g/2, so no division is needed.
+static bool fr_q_from3x3(const s32 *m, u16 r, FR_Quat *q)
+{
+	s32 a[9], u, g, v[4];
+	int i, k;
+	for (i = 0; i < 9; i++)
+		a[i] = fr_q_r28(m[i], r);
+	if (a[0] + a[4] + a[8] > 0)
+	{
+		k = 0;
+		u = a[0] + a[4] + a[8];
+		v[1] = a[7] - a[5];
+		v[2] = a[2] - a[6];
+		v[3] = a[3] - a[1];
+	}
+	else if (a[0] >= a[4] && a[0] >= a[8])
+	{
+		k = 1;
+		u = a[0] - a[4] - a[8];
+		v[0] = a[7] - a[5];
+		v[2] = a[1] + a[3];
+		v[3] = a[2] + a[6];
+	}
+	else if (a[4] >= a[8])
+	{
+		k = 2;
+		u = a[4] - a[0] - a[8];
+		v[0] = a[2] - a[6];
+		v[1] = a[1] + a[3];
+		v[3] = a[5] + a[7];
+	}
+	else
+	{
+		k = 3;
+		u = a[8] - a[0] - a[4];
+		v[0] = a[3] - a[1];
+		v[1] = a[2] + a[6];
+		v[2] = a[5] + a[7];
+	}
+	u += (s32)1 << 28;
+	if (u <= 0)
+		return false;
+	v[k] = u;
+	g = FR_rsqrt(u, 28);
+	for (i = 0; i < 4; i++) // s2.28 * s2.28 / 2 -> s1.30
+		v[i] = fr_q_sat(((s64)v[i] * g + ((s64)1 << 26)) >> 27);
+	if (v[0] < 0)
+		for (i = 0; i < 4; i++)
+			v[i] = -v[i];
+	q->set(v[0], v[1], v[2], v[3]);
+	return q->normalize();
+}
+
+//=======================================================
+//  Quaternion Functions
+
+s32 FR_Quat::dot(const FR_Quat *q) const
+{
+	s64 p[4];
+	p[0] = (s64)w * q->w;
+	p[1] = (s64)x * q->x;
+	p[2] = (s64)y * q->y;
+	p[3] = (s64)z * q->z;
+	return fr_q_sum(p, 4);
+}
+
+// Hamilton product; a point turned by the result is turned by pMul first
+void FR_Quat::mul(const FR_Quat *pMul)
+{
+	s64 aw = w, ax = x, ay = y, az = z;
+	s64 bw = pMul->w, bx = pMul->x, by = pMul->y, bz = pMul->z;
+	s64 p[4];
+	p[0] = aw * bw;	p[1] = -(ax * bx);	p[2] = -(ay * by);	p[3] = -(az * bz);
+	w = fr_q_sum(p, 4);
+	p[0] = aw * bx;	p[1] = ax * bw;	p[2] = ay * bz;	p[3] = -(az * by);
+	x = fr_q_sum(p, 4);
+	p[0] = aw * by;	p[1] = -(ax * bz);	p[2] = ay * bw;	p[3] = az * bx;
+	y = fr_q_sum(p, 4);
+	p[0] = aw * bz;	p[1] = ax * by;	p[2] = -(ay * bx);	p[3] = az * bw;
+	z = fr_q_sum(p, 4);
+}
+
+FR_Quat &FR_Quat::operator*=(const FR_Quat &q)
+{
+	mul(&q);
+	return *this;
+}
+
+//================================================================
+// normalize(): s = w^2 + x^2 + y^2 + z^2 (u64) is shifted by an even amount
+// into m in [2^29, 2^31) so that FR_rsqrt(m, 30) is in (0.7, 1.42] at s1.30;
+// the even shift comes back out as a power of two on the final rounding
+// shift.  INT_MIN components are taken as -INT_MAX so that s fits.
+bool FR_Quat::normalize()
+{
+	s64 c[4];
+	u64 s = 0;
+	s32 y0;
+	int b, sh, k, i;
+	c[0] = w;	c[1] = x;	c[2] = y;	c[3] = z;
+	for (i = 0; i < 4; i++)
+	{
+		if (c[i] == FR_OVERFLOW_NEG)
+			c[i] = -(s64)FR_OVERFLOW_POS;
+		s += (u64)(c[i] * c[i]);
+	}
+	if (0 == s)
+		return false;
+	b = fr_q_msb64(s);
+	sh = b - 29;
+	sh -= sh & 1; // even, msb(m) is 29 or 30
+	y0 = FR_rsqrt((s32)((sh >= 0) ? (s >> sh) : (s << -sh)), 30);
+	// 1/|q| = y0 * 2^((30 - sh) / 2) / 2^30, at s1.30 on output
+	k = 30 - (30 - sh) / 2;
+	for (i = 0; i < 4; i++)
+		c[i] = fr_q_sat((c[i] * y0 + ((k > 0) ? (s64)1 << (k - 1) : 0)) >> k);
+	set((s32)c[0], (s32)c[1], (s32)c[2], (s32)c[3]);
+	return true;
+}
+
+//================================================================
+// rotations, half angle from the s1.30 fr_sincos_bam32
+void FR_Quat::setrotateX(u16 bam)
+{
+	s32 s, c;
+	fr_sincos_bam32((u32)bam << 15, &s, &c);
+	set(c, s, 0, 0);
+}
+
+void FR_Quat::setrotateY(u16 bam)
+{
+	s32 s, c;
+	fr_sincos_bam32((u32)bam << 15, &s, &c);
+	set(c, 0, s, 0);
+}
+
+void FR_Quat::setrotateZ(u16 bam)
+{
+	s32 s, c;
+	fr_sincos_bam32((u32)bam << 15, &s, &c);
+	set(c, 0, 0, s);
+}
+
+// qz * qy * qx, matching FR_Matrix3D::setrotate
+void FR_Quat::setrotate(u16 bamx, u16 bamy, u16 bamz)
+{
+	FR_Quat t;
+	setrotateZ(bamz);
+	t.setrotateY(bamy);
+	mul(&t);
+	t.setrotateX(bamx);
+	mul(&t);
+}
+
+bool FR_Quat::setaxisangle(s32 ax, s32 ay, s32 az, u16 bam)
+{
+	FR_Quat n(0, ax, ay, az);
+	s32 s, c;
+	if (!n.normalize())
+	{
+		ID();
+		return false;
+	}
+	fr_sincos_bam32((u32)bam << 15, &s, &c);
+	set(c, fr_q_sat(((s64)n.x * s + ((s64)1 << 29)) >> 30),
+	    fr_q_sat(((s64)n.y * s + ((s64)1 << 29)) >> 30),
+	    fr_q_sat(((s64)n.z * s + ((s64)1 << 29)) >> 30));
+	return true;
+}
+
+//================================================================
+// matrix conversions
+
+void FR_Quat::tomatrix(FR_Matrix3D *m) const
+{
+	s32 a[9];
+	if (!m)
+		return;
+	fr_q_to3x3(this, m->radix, a);
+	m->m00 = a[0];	m->m01 = a[1];	m->m02 = a[2];
+	m->m10 = a[3];	m->m11 = a[4];	m->m12 = a[5];
+	m->m20 = a[6];	m->m21 = a[7];	m->m22 = a[8];
+	m->checkfast();
+}
+
+void FR_Quat::tomatrix(FR_Matrix2D_CPT *m) const
+{
+	s32 a[9];
+	if (!m)
+		return;
+	fr_q_to3x3(this, m->radix, a);
+	m->m00 = a[0];	m->m01 = a[1];
+	m->m10 = a[3];	m->m11 = a[4];
+	m->checkfast();
+}
+
+bool FR_Quat::frommatrix(const FR_Matrix3D *m)
+{
+	s32 a[9];
+	if (m)
+	{
+		a[0] = m->m00;	a[1] = m->m01;	a[2] = m->m02;
+		a[3] = m->m10;	a[4] = m->m11;	a[5] = m->m12;
+		a[6] = m->m20;	a[7] = m->m21;	a[8] = m->m22;
+		if (fr_q_from3x3(a, m->radix, this))
+			return true;
+	}
+	ID();
+	return false;
+}
+
+bool FR_Quat::frommatrix(const FR_Matrix2D_CPT *m)
+{
+	s32 a[9];
+	if (m)
+	{
+		a[0] = m->m00;	a[1] = m->m01;	a[2] = 0;
+		a[3] = m->m10;	a[4] = m->m11;	a[5] = 0;
+		a[6] = 0;		a[7] = 0;		a[8] = I2FR(1, m->radix);
+		if (fr_q_from3x3(a, m->radix, this))
+			return true;
+	}
+	ID();
+	return false;
+}
+
+//================================================================
+// Interpolation
+//
+// slerp(a, b, t) = (sin((1-t)h) a + sin(t h) b) / sin(h), h = acos(a.b).
+// h comes from FR_acos at s2.29 and is turned into a u0.32 phase (4/pi
+// scaled by 2^32), so the sines are fr_sin_bam32 lookups.  a.b >= 0 after
+// taking the shorter arc, so h <= pi/2 and every sine is >= 0.  The two
+// weights are divided once each and applied with exact 64-bit sums.
+
+struct fr_q_arc
+{
+	s32 sgn; // -1: b is negated for the shorter arc
+	int lin; // nlerp (a and b too close for the sines)
+	u32 ph;	 // h as a u0.32 phase
+	s32 sn;	 // sin(h), s1.30
+};
+
+static void fr_q_arc_set(const FR_Quat *a, const FR_Quat *b, fr_q_arc *arc)
+{
+	s32 d = a->dot(b);
+	arc->sgn = (d < 0) ? -1 : 1;
+	d = (d < 0) ? ((d == FR_OVERFLOW_NEG) ? FR_OVERFLOW_POS : -d) : d;
+	arc->lin = (d > FR_QUAT_NLERP_DOT);
+	arc->ph = 0;
+	arc->sn = 0;
+	if (!arc->lin)
+	{
+		u64 h = (u64)FR_acos(d, 30, 29);
+		u64 k = ((u64)1 << 32) + 0x45f306ddu; // 2^32 * 4/pi
+		arc->ph = (u32)((h * k + ((u64)1 << 31)) >> 32);
+		arc->sn = fr_sin_bam32(arc->ph);
+	}
+}
+
+// t clamped to [0, 2^prec]; a and b are copies (out may alias the inputs)
+static void fr_q_interp(const fr_q_arc *arc, FR_Quat a, FR_Quat b, s32 t, u16 prec, FR_Quat *out)
+{
+	s64 one = (s64)1 << prec, ka, kb, p[2];
+	s32 ca[4], cb[4], co[4];
+	int i;
+	t = (t < 0) ? 0 : ((t > one) ? (s32)one : t);
+	if (0 == t)
+	{
+		*out = a;
+		return;
+	}
+	ca[0] = a.w;	ca[1] = a.x;	ca[2] = a.y;	ca[3] = a.z;
+	cb[0] = b.w;	cb[1] = b.x;	cb[2] = b.y;	cb[3] = b.z;
+	if (t == one)
+	{
+		for (i = 0; i < 4; i++)
+			co[i] = fr_q_sat((s64)arc->sgn * cb[i]);
+		out->set(co[0], co[1], co[2], co[3]);
+		return;
+	}
+	if (arc->lin)
+	{
+		s64 rnd = (prec > 0) ? (s64)1 << (prec - 1) : 0;
+		for (i = 0; i < 4; i++)
+		{
+			s64 d = (s64)arc->sgn * cb[i] - ca[i];
+			co[i] = fr_q_sat(ca[i] + ((d * t + rnd) >> prec));
+		}
+		out->set(co[0], co[1], co[2], co[3]);
+		out->normalize();
+		return;
+	}
+	{
+		u32 tp = (u32)(((u64)arc->ph * (u64)t + (u64)(one >> 1)) >> prec);
+		ka = fr_q_div((s64)fr_sin_bam32(arc->ph - tp) << 30, arc->sn);
+		kb = fr_q_div((s64)fr_sin_bam32(tp) << 30, arc->sn) * arc->sgn;
+	}
+	for (i = 0; i < 4; i++)
+	{
+		p[0] = ka * ca[i];
+		p[1] = kb * cb[i];
+		co[i] = fr_q_sum(p, 2);
+	}
+	out->set(co[0], co[1], co[2], co[3]);
+}
+
+void FR_Quat::nlerp(const FR_Quat *a, const FR_Quat *b, s32 t, u16 prec)
+{
+	fr_q_arc arc;
+	if (!a || !b)
+		return;
+	arc.sgn = (a->dot(b) < 0) ? -1 : 1;
+	arc.lin = 1;
+	arc.ph = 0;
+	arc.sn = 0;
+	fr_q_interp(&arc, *a, *b, t, prec, this);
+}
+
+void FR_Quat::slerp(const FR_Quat *a, const FR_Quat *b, s32 t, u16 prec)
+{
+	fr_q_arc arc;
+	if (!a || !b)
+		return;
+	fr_q_arc_set(a, b, &arc);
+	fr_q_interp(&arc, *a, *b, t, prec, this);
+}
+
+static int fr_q_same(const FR_Quat *a, const FR_Quat *b)
+{
+	return (a->w == b->w) && (a->x == b->x) && (a->y == b->y) && (a->z == b->z);
+}
+
+void fr_quat_slerp_array(const FR_Quat *a, const FR_Quat *b, const s32 *t,
+                         FR_Quat *out, u32 n, u16 prec)
+{
+	fr_q_arc arc;
+	FR_Quat pa, pb;
+	u32 i;
+	if (!a || !b || !t || !out)
+		return;
+	for (i = 0; i < n; i++)
+	{
+		FR_Quat qa = a[i], qb = b[i];
+		if (0 == i || !fr_q_same(&qa, &pa) || !fr_q_same(&qb, &pb))
+		{
+			fr_q_arc_set(&qa, &qb, &arc);
+			pa = qa;
+			pb = qb;
+		}
+		fr_q_interp(&arc, qa, qb, t[i], prec, out + i);
+	}
+}
+//} //end namespace FR_MATH
@@ -0,0 +1,128 @@
+/**
+ *	@file FR_math_quat.h - header definition file for fixed radix quaternions
+ *
+ *	@copy Copyright (C) <2001-2026>  <M. A. Chatterjee>
+ *  @author M A Chatterjee <deftio [at] deftio [dot] com>
+ *	@version 2.0.8
+ *
+ *  This file contains integer math settable fixed point radix math routines for
+ *  use on systems in which floating point is not desired or unavailable.
+ *  Quaternions hold a rotation that composes without renormalising a matrix;
+ *  they convert to and from FR_Matrix3D and FR_Matrix2D_CPT.
+ *
+ *  @license:
+ *	This software is provided 'as-is', without any express or implied
+ *	warranty. In no event will the authors be held liable for any damages
+ *	arising from the use of this software.
+ *
+ *	Permission is granted to anyone to use this software for any purpose,
+ *	including commercial applications, and to alter it and redistribute it
+ *	freely, subject to the following restrictions:
+ *
+ *	1. The origin of this software must not be misrepresented; you must not
+ *	claim that you wrote the original software. If you use this software
+ *	in a product, an acknowledgment in the product documentation would be
+ *	appreciated but is not required.
+ *
+ *	2. Altered source versions must be plainly marked as such, and must not be
+ *	misrepresented as being the original software.
+ *
+ *	3. This notice may not be removed or altered from any source
+ *	distribution.
+ *
+ */
+
+#ifndef __FR_math_quat_h__
+#define __FR_math_quat_h__
+
+#ifndef __FR_math_2D_h__
+#include "FR_math_2D.h"
+#endif
+
+#ifndef __FR_math_3D_h__
+#include "FR_math_3D.h"
+#endif
+
+#ifdef __cplusplus
+// namespace  FR_MATH {
+extern "C"
+{
+#endif
+
+//===============================================
+// Fixed radix quaternion for rotations
+// Components are s1.30 (FR_QUAT_RADIX), w first.  A unit quaternion
+// (w, x, y, z) = (cos(a/2), sin(a/2) * axis) turns a point by a about axis.
+// q and -q are the same rotation.
+//================================================
+#define FR_QUAT_RADIX (30)
+#define FR_QUAT_ONE   ((s32)1 << FR_QUAT_RADIX)
+
+	struct FR_Quat
+	{
+		s32 w, x, y, z; // s1.30
+
+		//========================
+		void ID() { w = FR_QUAT_ONE; x = y = z = 0; } // identity (no rotation)
+
+		//=======================
+		FR_Quat() : w(FR_QUAT_ONE), x(0), y(0), z(0) {};
+		FR_Quat(s32 nw, s32 nx, s32 ny, s32 nz) : w(nw), x(nx), y(ny), z(nz) {};
+
+		void set(s32 nw, s32 nx, s32 ny, s32 nz) { w = nw; x = nx; y = ny; z = nz; }
+		void conj() { x = -x; y = -y; z = -z; } // inverse of a unit quaternion
+		s32 dot(const FR_Quat *q) const;		// w*w' + x*x' + y*y' + z*z', s1.30, saturated
+
+		// rotation by bam (BAM, 65536 per turn) about the axis (ax, ay, az); the
+		// axis may have any length and radix.  A zero axis gives the identity
+		// and returns false.
+		bool setaxisangle(s32 ax, s32 ay, s32 az, u16 bam);
+		void setrotateX(u16 bam);
+		void setrotateY(u16 bam);
+		void setrotateZ(u16 bam);
+		void setrotate(u16 bamx, u16 bamy, u16 bamz); // X first, then Y, then Z (as FR_Matrix3D)
+
+		// this = this*pMul (pMul applied first, as FR_Matrix3D::mul); pMul may be this.
+		// Each component is an exact 64-bit sum, rounded once and saturated.
+		void mul(const FR_Quat *pMul);
+		FR_Quat &operator*=(const FR_Quat &q);
+
+		// scale to unit length with FR_rsqrt (no division); returns false and
+		// leaves a zero quaternion unchanged.  Any s32 components are accepted.
+		bool normalize();
+
+		// rotation matrix of a unit quaternion, rounded to the matrix radix
+		// (0..30).  The 3x3 (2x2) part is overwritten and the translation kept,
+		// as setrotate() does.  The 2D form is the upper left 2x2, which is the
+		// rotation itself when the axis is Z.
+		void tomatrix(FR_Matrix3D *m) const;
+		void tomatrix(FR_Matrix2D_CPT *m) const;
+		// rotation from the 3x3 (2x2) part of m (Shepperd's method with
+		// FR_rsqrt), normalised, w >= 0.  Returns false (and sets the identity)
+		// if m is NULL or has no rotation part (e.g. a zero or mirrored 3x3).
+		bool frommatrix(const FR_Matrix3D *m);
+		bool frommatrix(const FR_Matrix2D_CPT *m);
+
+		// interpolate from a (t = 0) to b (t = 2^prec) along the shorter arc; t
+		// is clamped to [0, 2^prec], prec <= 30.  nlerp blends the components and
+		// normalises; slerp keeps a constant angular rate (FR_acos, fr_sin_bam32)
+		// and falls back to nlerp when a.b > 1 - 2^-14 (about 0.01 rad).  Ends are
+		// exact: t = 0 gives a, t = 2^prec gives b (or -b for the shorter arc).
+		void nlerp(const FR_Quat *a, const FR_Quat *b, s32 t, u16 prec);
+		void slerp(const FR_Quat *a, const FR_Quat *b, s32 t, u16 prec);
+	};
+
+	//========================
+	// fr_quat_slerp_array: out[i] = slerp(a[i], b[i], t[i]), i < n, point for
+	// point the same as FR_Quat::slerp.  For animation tracks: when a pair
+	// repeats (several samples between the same two keys) its angle and
+	// sine are reused.  out may overwrite a or b; NULL pointers are a no-op.
+	void fr_quat_slerp_array(const FR_Quat *a, const FR_Quat *b, const s32 *t,
+	                         FR_Quat *out, u32 n, u16 prec);
+
+#ifdef __cplusplus
+} // extern "C"
+//} // name space
+#endif
+
+#endif /* __FR_math_quat_h__ */
@@ -0,0 +1,44 @@
+/**
+ *	@file FR_simd_x86.h - internal: x86 SIMD build detection shared by the
+ *	                      FR_math sources (not part of the public API)
+ *
+ *	@copy Copyright (C) <2001-2026>  <M. A. Chatterjee>
+ *  @author M A Chatterjee <deftio [at] deftio [dot] com>
+ *
+ *	This software is provided 'as-is', without any express or implied
+ *	warranty. In no event will the authors be held liable for any damages
+ *	arising from the use of this software.
+ *
+ *	Permission is granted to anyone to use this software for any purpose,
+ *	including commercial applications, and to alter it and redistribute it
+ *	freely, subject to the following restrictions:
+ *
+ *	1. The origin of this software must not be misrepresented; you must not
+ *	claim that you wrote the original software. If you use this software
+ *	in a product, an acknowledgment in the product documentation would be
+ *	appreciated but is not required.
+ *
+ *	2. Altered source versions must be plainly marked as such, and must not be
+ *	misrepresented as being the original software.
+ *
+ *	3. This notice may not be removed or altered from any source
+ *	distribution.
+ *
+ */
+
+#ifndef __FR_simd_x86_h__
+#define __FR_simd_x86_h__
+
+/* FR_SIMD_X86: opt-in AVX2 / SSE4.1 kernels with run-time CPU dispatch.
+ * Needs GCC or Clang (function-level target attributes and
+ * __builtin_cpu_supports); on other compilers or targets
+ * FR_SIMD_X86_ACTIVE stays undefined, the portable loops are used and
+ * fr_simd_x86_level() reports FR_SIMD_NONE. */
+#if defined(FR_SIMD_X86) && !defined(FR_NO_ARRAY) && \
+    (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define FR_SIMD_X86_ACTIVE
+#include <immintrin.h>
+#endif
+
+#endif /* __FR_simd_x86_h__ */
@@ -0,0 +1,37 @@
+/*
+ * fr_test_util.h - fixtures shared by the C and C++ test suites
+ *
+ * @author M A Chatterjee <deftio [at] deftio [dot] com>
+ */
+
+#ifndef __FR_test_util_h__
+#define __FR_test_util_h__
+
+#include "../src/FR_math.h"
+
+/* One step of the LCG the array tests draw their inputs from. */
+static inline u32 fr_test_lcg(u32 seed)
+{
+    return seed * 1103515245u + 12345u;
+}
+
+/* Run check(ctx) with the x86 SIMD level capped at every level from the
+ * current one down to FR_SIMD_NONE, stopping at the first failure, then
+ * put the caller's cap back.  Returns 1 if every level passed.  Without
+ * FR_SIMD_X86 there is only the scalar path and check runs once. */
+static inline int fr_test_simd_levels(int (*check)(void *ctx), void *ctx)
+{
+#ifdef FR_SIMD_X86
+    int saved = fr_simd_x86_level(), lvl, ok = 1;
+    for (lvl = saved; ok && lvl >= FR_SIMD_NONE; lvl--) {
+        fr_simd_x86_limit(lvl);
+        ok = check(ctx);
+    }
+    fr_simd_x86_limit(saved);
+    return ok;
+#else
+    return check(ctx);
+#endif
+}
+
+#endif /* __FR_test_util_h__ */
@@ -5,7 +5,9 @@
 
 #include <stdio.h>
 #include <string.h>
+#include <math.h>
 #include "../src/FR_math_2D.h"
+#include "fr_test_util.h"
 
 #define TEST_PASS 0
 #define TEST_FAIL 1
@@ -185,6 +187,72 @@ int test_matrix_ops() {
 }
 
 /* Test determinant and inverse */
+/* Test matrix composition: (A*B)(p) == A(B(p)) within rounding */
+int test_matrix_mul() {
+    FR_Matrix2D_CPT a(14), b(8), c(14), d(8);
+    s32 x, y, xp, yp;
+    double xb, yb, xr, yr;
+
+    // rotate + translate at radix 14 composed with scale + translate at radix 8
+    a.setrotate(30);
+    a.XlateI(10, 20);
+    b.set(I2FR(2, 8), 0, I2FR(3, 8), 0, I2FR(3, 8) / 2, -I2FR(4, 8), 8);
+    c = a;
+    c *= b;
+    if (c.radix != 14 || c.fast) return TEST_FAIL;
+    for (x = -300; x <= 300; x += 37) {
+        for (y = -200; y <= 200; y += 41) {
+            // c at radix 14 vs b then a, exactly, in double
+            c.XFormPtI(x, y, &xp, &yp, 0);
+            xb = (x * (double)b.m00 + y * (double)b.m01 + b.m02) / 256.0;
+            yb = (x * (double)b.m10 + y * (double)b.m11 + b.m12) / 256.0;
+            xr = xb * a.m00 + yb * a.m01 + a.m02;
+            yr = xb * a.m10 + yb * a.m11 + a.m12;
+            if (xp - xr > 2 * 300 || xr - xp > 2 * 300) return TEST_FAIL;
+            if (yp - yr > 2 * 300 || yr - yp > 2 * 300) return TEST_FAIL;
+        }
+    }
+
+    // identity on either side is exact, whatever its radix
+    d.ID();
+    c = a;
+    c.mul(&d);
+    if (c.m00 != a.m00 || c.m01 != a.m01 || c.m02 != a.m02 ||
+        c.m10 != a.m10 || c.m11 != a.m11 || c.m12 != a.m12) return TEST_FAIL;
+    c = b;
+    c *= FR_Matrix2D_CPT(3);
+    if (c.m00 != b.m00 || c.m11 != b.m11 || c.m02 != b.m02 || c.m12 != b.m12) return TEST_FAIL;
+
+    // fast follows the product: two rotations that cancel become scale-only
+    c = b;
+    d = b;
+    c.setrotate(90);
+    d.setrotate(-90);
+    if (c.fast || d.fast) return TEST_FAIL;
+    c *= d;
+    if (!c.fast || c.m00 != I2FR(1, 8) || c.m11 != I2FR(1, 8)) return TEST_FAIL;
+
+    // multiplying by itself uses the old values throughout
+    c = a;
+    d = a;
+    c *= c;
+    d.mul(&a);
+    if (c.m00 != d.m00 || c.m01 != d.m01 || c.m02 != d.m02 ||
+        c.m10 != d.m10 || c.m11 != d.m11 || c.m12 != d.m12) return TEST_FAIL;
+
+    // saturation, including (-2^31)^2 + (-2^31)^2 which overflows s64
+    c.set(I2FR(1000, 16), 0, 0x7fff0000, 0, I2FR(1, 16), 0, 16);
+    d.set(0x40000000, 0, I2FR(1000, 16), 0, I2FR(1, 16), -I2FR(3, 16), 16);
+    c *= d;
+    if (c.m00 != FR_OVERFLOW_POS || c.m02 != FR_OVERFLOW_POS || c.m12 != -I2FR(3, 16)) return TEST_FAIL;
+    if (!c.fast) return TEST_FAIL;
+    c.set(FR_OVERFLOW_NEG, FR_OVERFLOW_NEG, 0, FR_OVERFLOW_NEG, FR_OVERFLOW_NEG, 0, 0);
+    c *= c;
+    if (c.m00 != FR_OVERFLOW_POS || c.m11 != FR_OVERFLOW_POS) return TEST_FAIL;
+
+    return TEST_PASS;
+}
+
 int test_det_inv() {
     FR_Matrix2D_CPT mat(8), inv_mat(8);
     s32 det;
@@ -215,6 +283,80 @@ int test_det_inv() {
     return TEST_PASS;
 }
 
+/* Batch transforms match the scalar methods point for point: planar and
+ * interleaved, s32 and s16 (including s16 wraparound), fast and full
+ * matrices, in place, and with FR_SIMD_X86 at every dispatch level.
+ * n = 37 leaves a tail after the 8- and 16-point SIMD blocks. */
+#define XF_N 37
+struct xf_batch { FR_Matrix2D_CPT *mat; const s32 *xs, *ys; };
+static int batch_matches(void *ctx) {
+    xf_batch *b = (xf_batch *)ctx;
+    FR_Matrix2D_CPT &mat = *b->mat;
+    const s32 *xs = b->xs, *ys = b->ys;
+    s32 xp[XF_N], yp[XF_N], xy[2 * XF_N], ex, ey;
+    s16 xs16[XF_N], ys16[XF_N], xp16[XF_N], yp16[XF_N], xy16[2 * XF_N], ex16, ey16;
+    u32 i;
+
+    mat.XFormPtsI(xs, ys, xp, yp, XF_N, 5);
+    for (i = 0; i < XF_N; i++) {
+        mat.XFormPtI(xs[i], ys[i], &ex, &ey, 5);
+        if (xp[i] != ex || yp[i] != ey) return 0;
+    }
+    mat.XFormPtsI(xs, ys, xp, yp, XF_N);
+    for (i = 0; i < XF_N; i++) { xy[2 * i] = xs[i]; xy[2 * i + 1] = ys[i]; }
+    mat.XFormPtsI(xy, xy, XF_N);                     /* in place */
+    for (i = 0; i < XF_N; i++) {
+        mat.XFormPtI(xs[i], ys[i], &ex, &ey);
+        if (xp[i] != ex || yp[i] != ey) return 0;
+        if (xy[2 * i] != ex || xy[2 * i + 1] != ey) return 0;
+    }
+
+    for (i = 0; i < XF_N; i++) {
+        xs16[i] = (s16)(xs[i] * 3); ys16[i] = (s16)(ys[i] * 3);
+        xy16[2 * i] = xs16[i]; xy16[2 * i + 1] = ys16[i];
+    }
+    mat.XFormPtsI16(xs16, ys16, xp16, yp16, XF_N);
+    mat.XFormPtsI16(xy16, xy16, XF_N);
+    for (i = 0; i < XF_N; i++) {
+        mat.XFormPtI16(xs16[i], ys16[i], &ex16, &ey16);
+        if (xp16[i] != ex16 || yp16[i] != ey16) return 0;
+        if (xy16[2 * i] != ex16 || xy16[2 * i + 1] != ey16) return 0;
+    }
+    return 1;
+}
+
+int test_batch_xform() {
+    FR_Matrix2D_CPT mat(10);
+    s32 xs[XF_N], ys[XF_N];
+    xf_batch b = { &mat, xs, ys };
+    u32 i, seed = 99u, pass;
+
+    for (i = 0; i < XF_N; i++) {
+        seed = fr_test_lcg(seed);
+        xs[i] = (s32)(seed >> 16) - 32768 / 3;       /* |x| * 3 overflows s16 */
+        ys[i] = (s32)((seed >> 4) & 0x7FFF) - 16384;
+    }
+    for (pass = 0; pass < 2; pass++) {
+        if (pass == 0)
+            mat.set(I2FR(3, 10) / 2, 0, -I2FR(40, 10), 0, -I2FR(2, 10), I2FR(7, 10) + 3, 10);
+        else {
+            mat.setrotate(33);
+            mat.XlateI(-12, 250);
+            mat.m00 += 17;                           /* some shear too */
+        }
+        if (mat.fast != (pass == 0)) return TEST_FAIL;
+        if (!fr_test_simd_levels(batch_matches, &b)) return TEST_FAIL;
+    }
+
+    /* NULL is a no-op */
+    xs[0] = 5;
+    mat.XFormPtsI((const s32 *)0, ys, xs, ys, XF_N, 4);
+    mat.XFormPtsI((const s32 *)0, xs, XF_N);
+    mat.XFormPtsI16((const s16 *)0, (s16 *)0, XF_N);
+    if (xs[0] != 5) return TEST_FAIL;
+    return TEST_PASS;
+}
+
 /* Test fast mode detection */
 int test_fast_mode() {
     FR_Matrix2D_CPT mat(8);
@@ -249,6 +391,202 @@ int test_fast_mode() {
     return TEST_PASS;
 }
 
+/* Span iterator: exact against an s64 reference after long spans, equal
+ * to XFormPtI for integer starts, sub-pixel starts and steps, skips. */
+int test_span() {
+    static const s32 mats[3][6] = {
+        { 181, -181, 7 << 8, 181, 181, -(3 << 8) },            /* rotate 45, radix 8 */
+        { 46341, 23170, -12345, -23170, 46341, 99999 },         /* radix 16 */
+        { 3, 0, 5, 0, -7, 1 },                                  /* radix 2, fast */
+    };
+    static const u16 rdx[3] = { 8, 16, 2 };
+    FR_Matrix2D_CPT mat;
+    FR_Span2D s, t;
+    s32 xp[300], yp[300], ex, ey;
+    int k, i;
+
+    for (k = 0; k < 3; k++) {
+        const s32 *a = mats[k];
+        u16 r = rdx[k];
+        mat.set(a[0], a[1], a[2], a[3], a[4], a[5], r);
+
+        /* integer row: the same as XFormPtI, at two output shifts */
+        mat.XFormSpanI(-150, 37, xp, yp, 300, r);
+        for (i = 0; i < 300; i++) {
+            mat.XFormPtI(-150 + i, 37, &ex, &ey);
+            if (xp[i] != ex || yp[i] != ey) return TEST_FAIL;
+        }
+        mat.XFormSpanI(-150, 37, xp, yp, 300, 1);
+        for (i = 0; i < 300; i++) {
+            mat.XFormPtI(-150 + i, 37, &ex, &ey, 1);
+            if (xp[i] != ex || yp[i] != ey) return TEST_FAIL;
+        }
+
+        /* pixel centres (radix 1) along a diagonal, 10^6 steps: no drift */
+        mat.SpanI(&s, 2 * 3 + 1, 2 * -5 + 1, 2, -1, 1, r);
+        for (i = 0; i < 1000000; i++) s.step();
+        {
+            s64 px = 7 + 2 * (s64)1000000, py = -9 - (s64)1000000;
+            s64 rx = px * a[0] + py * a[1] + 2 * (s64)a[2];
+            s64 ry = px * a[3] + py * a[4] + 2 * (s64)a[5];
+            if (s.xp() != (s32)(rx >> (r + 1)) || s.yp() != (s32)(ry >> (r + 1))) return TEST_FAIL;
+        }
+
+        /* step(k) is k steps; fill advances the span */
+        mat.SpanI(&s, 10, 20, 3, 1, 0, 0);
+        t = s;
+        for (i = 0; i < 77; i++) t.step();
+        s.step(77);
+        if (s.xp() != t.xp() || s.yp() != t.yp()) return TEST_FAIL;
+        s.fill(xp, yp, 5);
+        t.step(5);
+        if (s.x != t.x || s.y != t.y) return TEST_FAIL;
+    }
+    s.fill((s32 *)0, yp, 5);                    /* NULL is a no-op */
+    if (s.x != t.x) return TEST_FAIL;
+    mat.SpanI((FR_Span2D *)0, 1, 2, 0);
+    return TEST_PASS;
+}
+
+/* Warp: exact cases, a double reference for both filters, bands, errors */
+#define WS 40
+#define WD 48
+static u8 wsrc[WS * WS], wdst[WD * WD], wdst2[WD * WD];
+static u16 wsrc16[WS * WS], wdst16[WD * WD];
+
+/* source position of destination pixel centre (x, y) under the inverse of a */
+static void warp_ref_pos(const double *a, int x, int y, double *u, double *v) {
+    double det = a[0] * a[4] - a[1] * a[3];
+    double px = x + 0.5 - a[2], py = y + 0.5 - a[5];
+    *u = (a[4] * px - a[1] * py) / det;
+    *v = (a[0] * py - a[3] * px) / det;
+}
+static int near_int(double t) { return fabs(t - floor(t + 0.5)) < 1e-3; }
+
+int test_warp() {
+    FR_Image8 src = { wsrc, WS, WS, WS }, dst = { wdst, WD, WD, WD }, dst2 = { wdst2, WD, WD, WD };
+    FR_Image16 src16 = { wsrc16, WS, WS, WS }, dst16 = { wdst16, WD, WD, WD };
+    FR_Matrix2D_CPT mat(16);
+    int x, y, mode;
+
+    for (y = 0; y < WS; y++)
+        for (x = 0; x < WS; x++) {
+            wsrc[y * WS + x] = (u8)((x * 37 + y * 91 + x * y) & 0xff);
+            wsrc16[y * WS + x] = (u16)(wsrc[y * WS + x] * 257 ^ (x << 3));
+        }
+
+    /* identity: an exact copy in both modes, fill beyond the source */
+    for (mode = FR_WARP_NEAREST; mode <= FR_WARP_BILINEAR; mode++) {
+        mat.ID();
+        if (!mat.Warp(&src, &dst, mode, 7)) return TEST_FAIL;
+        for (y = 0; y < WD; y++)
+            for (x = 0; x < WD; x++)
+                if (wdst[y * WD + x] != ((x < WS && y < WS) ? wsrc[y * WS + x] : 7)) return TEST_FAIL;
+    }
+
+    /* integer translate (dst = src + (5, -3)) */
+    mat.set(I2FR(1, 16), 0, I2FR(5, 16), 0, I2FR(1, 16), -I2FR(3, 16), 16);
+    for (mode = FR_WARP_NEAREST; mode <= FR_WARP_BILINEAR; mode++) {
+        if (!mat.Warp(&src, &dst, mode, 0)) return TEST_FAIL;
+        for (y = 0; y < WD; y++)
+            for (x = 0; x < WD; x++) {
+                int u = x - 5, v = y + 3;
+                u8 e = (u >= 0 && u < WS && v >= 0 && v < WS) ? wsrc[v * WS + u] : 0;
+                if (wdst[y * WD + x] != e) return TEST_FAIL;
+            }
+    }
+
+    /* 90 degrees at radix 8: x' = WS - y, y' = x, an exact permutation */
+    mat.set(0, -I2FR(1, 8), I2FR(WS, 8), I2FR(1, 8), 0, 0, 8);
+    for (mode = FR_WARP_NEAREST; mode <= FR_WARP_BILINEAR; mode++) {
+        if (!mat.Warp(&src, &dst, mode, 1)) return TEST_FAIL;
+        for (y = 0; y < WS; y++)
+            for (x = 0; x < WS; x++)
+                if (wdst[y * WD + x] != wsrc[(WS - 1 - x) * WS + y]) return TEST_FAIL;
+    }
+
+    /* rotation + scale + subpixel shift against a double reference */
+    {
+        static const double a[6] = { 1.1 * 0.8660254, -1.1 * 0.5, 12.3, 1.1 * 0.5, 1.1 * 0.8660254, -6.7 };
+        s32 fa[6];
+        int i, bad = 0;
+        for (i = 0; i < 6; i++) fa[i] = (s32)floor(a[i] * 65536.0 + 0.5);
+        mat.set(fa[0], fa[1], fa[2], fa[3], fa[4], fa[5], 16);
+        if (!mat.Warp(&src, &dst, FR_WARP_NEAREST, 3)) return TEST_FAIL;
+        if (!mat.Warp(&src16, &dst16, FR_WARP_NEAREST, 9)) return TEST_FAIL;
+        for (y = 0; y < WD; y++)
+            for (x = 0; x < WD; x++) {
+                double u, v;
+                int iu, iv, in;
+                warp_ref_pos(a, x, y, &u, &v);
+                if (near_int(u) || near_int(v)) continue;
+                iu = (int)floor(u); iv = (int)floor(v);
+                in = (iu >= 0 && iu < WS && iv >= 0 && iv < WS);
+                if (wdst[y * WD + x] != (in ? wsrc[iv * WS + iu] : 3)) bad++;
+                if (wdst16[y * WD + x] != (in ? wsrc16[iv * WS + iu] : 9)) bad++;
+            }
+        if (bad) return TEST_FAIL;
+
+        if (!mat.Warp(&src, &dst, FR_WARP_BILINEAR, 3)) return TEST_FAIL;
+        if (!mat.Warp(&src16, &dst16, FR_WARP_BILINEAR, 9)) return TEST_FAIL;
+        for (y = 0; y < WD; y++)
+            for (x = 0; x < WD; x++) {
+                double u, v, fx, fy, e8, e16;
+                int x0, y0, x1, y1;
+                warp_ref_pos(a, x, y, &u, &v);
+                if (near_int(u) || near_int(v)) continue;
+                if (u < 0 || u >= WS || v < 0 || v >= WS) {
+                    if (wdst[y * WD + x] != 3 || wdst16[y * WD + x] != 9) return TEST_FAIL;
+                    continue;
+                }
+                u -= 0.5; v -= 0.5;
+                x0 = (int)floor(u); y0 = (int)floor(v);
+                fx = u - x0; fy = v - y0;
+                x1 = (x0 + 1 < WS) ? x0 + 1 : WS - 1; y1 = (y0 + 1 < WS) ? y0 + 1 : WS - 1;
+                if (x0 < 0) x0 = 0;
+                if (y0 < 0) y0 = 0;
+#define WBL(p) ((p[y0 * WS + x0] * (1 - fx) + p[y0 * WS + x1] * fx) * (1 - fy) + \
+                (p[y1 * WS + x0] * (1 - fx) + p[y1 * WS + x1] * fx) * fy)
+                e8 = WBL(wsrc);
+                e16 = WBL(wsrc16);
+#undef WBL
+                if (fabs(wdst[y * WD + x] - e8) > 2.0) return TEST_FAIL;
+                if (fabs(wdst16[y * WD + x] - e16) > 2.0 * 257) return TEST_FAIL;
+            }
+
+        /* two row bands (any split, e.g. one per thread) equal one pass */
+        memset(wdst2, 0x55, sizeof(wdst2));
+        if (!mat.Warp(&src, &dst2, FR_WARP_BILINEAR, 3, -10, 17)) return TEST_FAIL;
+        if (!mat.Warp(&src, &dst2, FR_WARP_BILINEAR, 3, 17, 1000)) return TEST_FAIL;
+        if (memcmp(wdst, wdst2, sizeof(wdst))) return TEST_FAIL;
+    }
+
+    /* pitch wider than the image: padding is neither read nor written */
+    {
+        FR_Image8 s2 = { wsrc, 20, 20, WS }, d2 = { wdst2, 30, 30, WD };
+        memset(wdst2, 0xaa, sizeof(wdst2));
+        mat.ID();
+        if (!mat.Warp(&s2, &d2, FR_WARP_BILINEAR, 0)) return TEST_FAIL;
+        for (y = 0; y < WD; y++)
+            for (x = 0; x < WD; x++) {
+                u8 e = (x < 20 && y < 20) ? wsrc[y * WS + x] : (x < 30 && y < 30) ? 0 : 0xaa;
+                if (wdst2[y * WD + x] != e) return TEST_FAIL;
+            }
+    }
+
+    /* errors: singular matrix, inverse beyond s15.16, NULL or empty images */
+    mat.set(I2FR(1, 16), I2FR(2, 16), 0, I2FR(2, 16), I2FR(4, 16), 0, 16);
+    if (mat.Warp(&src, &dst, FR_WARP_NEAREST, 0)) return TEST_FAIL;
+    mat.set(1, 0, 0, 0, 1, 0, 16);
+    if (mat.Warp(&src, &dst, FR_WARP_NEAREST, 0)) return TEST_FAIL;
+    mat.ID();
+    if (mat.Warp((FR_Image8 *)0, &dst, FR_WARP_NEAREST, 0)) return TEST_FAIL;
+    if (mat.Warp(&src, (FR_Image8 *)0, FR_WARP_NEAREST, 0)) return TEST_FAIL;
+    dst2.w = 0;
+    if (mat.Warp(&src, &dst2, FR_WARP_NEAREST, 0)) return TEST_FAIL;
+    return TEST_PASS;
+}
+
 /* Dark-corner branches in FR_math_2D.cpp::inv() that the main tests
  * don't hit. Two distinct lines:
  *   1. inv(&this) self-alias guard → returns false
@@ -321,11 +659,15 @@ int main() {
     
     printf("\nMatrix Operations:\n");
     RUN_TEST(test_matrix_ops);
+    RUN_TEST(test_matrix_mul);
     RUN_TEST(test_det_inv);
     RUN_TEST(test_inv_edge_branches);
 
     printf("\nOptimizations:\n");
     RUN_TEST(test_fast_mode);
+    RUN_TEST(test_batch_xform);
+    RUN_TEST(test_span);
+    RUN_TEST(test_warp);
     
     printf("\nEdge Cases:\n");
     RUN_TEST(test_edge_cases);
@@ -0,0 +1,395 @@
+/*
+ * test_3d_complete.cpp - Complete test coverage for FR_math_3D
+ * Tests the C++ 3D transformation matrix class
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "../src/FR_math_3D.h"
+#include "fr_test_util.h"
+
+#define TEST_PASS 0
+#define TEST_FAIL 1
+
+static int test_count = 0;
+static int fail_count = 0;
+
+#define RUN_TEST(test_func) do { \
+    printf("  %s: ", #test_func); \
+    test_count++; \
+    if (test_func() == TEST_PASS) { \
+        printf("PASS\n"); \
+    } else { \
+        printf("FAIL\n"); \
+        fail_count++; \
+    } \
+} while(0)
+
+static u32 g_seed = 12345u;
+static s32 rnd(s32 lim) {     /* uniform in [-lim, lim) */
+    g_seed = fr_test_lcg(g_seed);
+    return (s32)((g_seed >> 8) % (u32)(2 * lim)) - lim;
+}
+
+static void get16(const FR_Matrix3D &m, s32 *a) {
+    const s32 v[16] = { m.m00, m.m01, m.m02, m.m03, m.m10, m.m11, m.m12, m.m13,
+                        m.m20, m.m21, m.m22, m.m23, m.m30, m.m31, m.m32, m.m33 };
+    memcpy(a, v, sizeof(v));
+}
+
+/* max |a - b| over the 16 elements */
+static s32 maxdiff(const FR_Matrix3D &a, const FR_Matrix3D &b) {
+    s32 x[16], y[16], d = 0;
+    int i;
+    get16(a, x);
+    get16(b, y);
+    for (i = 0; i < 16; i++) {
+        s32 e = x[i] > y[i] ? x[i] - y[i] : y[i] - x[i];
+        if (e > d) d = e;
+    }
+    return d;
+}
+
+/* Test identity, set and the fast / proj flags */
+int test_identity() {
+    FR_Matrix3D m(12);
+    s32 a[16];
+    const s32 aff[12] = { I2FR(2, 8), 0, 0, I2FR(5, 8),
+                          0, I2FR(3, 8), 0, -I2FR(1, 8),
+                          0, 0, I2FR(1, 8) / 2, 7 };
+    const s32 prj[16] = { 256, 0, 0, 0, 0, 256, 0, 0, 0, 0, 256, 0, 0, 0, 64, 256 };
+
+    get16(m, a);
+    if (m.radix != 12 || !m.fast || m.proj) return TEST_FAIL;
+    if (a[0] != I2FR(1, 12) || a[5] != I2FR(1, 12) || a[10] != I2FR(1, 12) || a[15] != I2FR(1, 12))
+        return TEST_FAIL;
+    if (a[1] | a[2] | a[3] | a[4] | a[6] | a[7] | a[8] | a[9] | a[11] | a[12] | a[13] | a[14])
+        return TEST_FAIL;
+
+    m.set(aff, 8);
+    if (m.radix != 8 || !m.fast || m.proj || m.m03 != I2FR(5, 8) || m.m23 != 7) return TEST_FAIL;
+    if (m.m30 || m.m31 || m.m32 || m.m33 != I2FR(1, 8)) return TEST_FAIL;
+    m.m12 = 1;
+    if (m.checkfast()) return TEST_FAIL;
+
+    m.set4x4(prj, 8);
+    if (!m.fast || !m.proj || m.m32 != 64) return TEST_FAIL;
+    m.set((const s32 *)0, 3);                      /* NULL is a no-op */
+    if (m.radix != 8 || m.m32 != 64) return TEST_FAIL;
+    return TEST_PASS;
+}
+
+/* Test rotations, translation and point transforms */
+int test_rotation_xform() {
+    FR_Matrix3D m(14);
+    s32 x, y, z;
+
+    m.setrotateZ(0x4000);                          /* 90 degrees */
+    if (m.m00 != 0 || m.m01 != -I2FR(1, 14) || m.m10 != I2FR(1, 14) || m.m22 != I2FR(1, 14))
+        return TEST_FAIL;
+    m.XFormPtI(100, 0, 7, &x, &y, &z);
+    if (x != 0 || y != 100 || z != 7) return TEST_FAIL;
+
+    m.setrotateX(0x4000);                          /* y -> z */
+    m.XFormPtI(3, 100, 0, &x, &y, &z);
+    if (x != 3 || y != 0 || z != 100) return TEST_FAIL;
+
+    m.setrotateY(0x4000);                          /* z -> x */
+    m.XlateI(10, 20, 30);
+    m.XFormPtI(0, 5, 100, &x, &y, &z);
+    if (x != 110 || y != 25 || z != 30) return TEST_FAIL;
+    m.XFormPtINoTranslate(0, 5, 100, &x, &y, &z, 14);
+    if (x != 100 || y != 5 || z != 0) return TEST_FAIL;
+    m.XlateRelativeI(1, 1, 1);
+    if (m.m03 != I2FR(11, 14) || m.m23 != I2FR(31, 14)) return TEST_FAIL;
+
+    /* X then Y then Z: (1,0,0) -X90-> (1,0,0) -Y90-> (0,0,-1) -Z90-> (0,0,-1) */
+    m.setrotate(0x4000, 0x4000, 0x4000);
+    m.XFormPtINoTranslate(1000, 0, 0, &x, &y, &z, 14);
+    if (x != 0 || y != 0 || z != -1000) return TEST_FAIL;
+    /* (0,1,0) -X90-> (0,0,1) -Y90-> (1,0,0) -Z90-> (0,1,0) */
+    m.XFormPtINoTranslate(0, 1000, 0, &x, &y, &z, 14);
+    if (x != 0 || y != 1000 || z != 0) return TEST_FAIL;
+    /* translation is kept */
+    if (m.m03 != I2FR(11, 14) || m.m13 != I2FR(21, 14)) return TEST_FAIL;
+
+    /* fast (scale / translate) path */
+    m.ID();
+    m.m00 = I2FR(2, 14);
+    m.m22 = -I2FR(1, 14);
+    m.XlateI(1, 2, 3);
+    if (!m.checkfast()) return TEST_FAIL;
+    m.XFormPtI(5, 6, 7, &x, &y, &z);
+    if (x != 11 || y != 8 || z != -4) return TEST_FAIL;
+    m.XFormPtINoTranslate(5, 6, 7, &x, &y, &z, 14);
+    if (x != 10 || y != 6 || z != -7) return TEST_FAIL;
+
+    /* radix 30 rotation is the s1.30 value itself */
+    FR_Matrix3D h(30);
+    h.setrotateZ(0x2000);
+    if (h.m00 != fr_cos_bam32(FR_BAM2PHASE32(0x2000))) return TEST_FAIL;
+    return TEST_PASS;
+}
+
+/* Test composition: exact rounding at every radix, mixed radix, saturation */
+int test_mul() {
+    FR_Matrix3D a(8), b(8), c(8), d(8);
+    s32 x[16], y[16], o[16];
+    int i, j, k, r, t;
+
+    /* the product at radix r is round(sum / 2^r), checked against a plain
+       s64 reference on values small enough for it */
+    for (r = 0; r <= 10; r++) {
+        for (t = 0; t < 20; t++) {
+            for (i = 0; i < 16; i++) {
+                x[i] = rnd(1 << 20);
+                y[i] = rnd(1 << 20);
+            }
+            a.set4x4(x, 9);
+            b.set4x4(y, (u16)r);
+            a *= b;
+            get16(a, o);
+            for (i = 0; i < 4; i++) {
+                for (j = 0; j < 4; j++) {
+                    s64 s = 0;
+                    for (k = 0; k < 4; k++) s += (s64)x[4 * i + k] * y[4 * k + j];
+                    if (r) s = (s + ((s64)1 << (r - 1))) >> r;
+                    if (s > 0x7fffffff) s = 0x7fffffff;
+                    if (s < -(s64)0x80000000) s = -(s64)0x80000000;
+                    if (o[4 * i + j] != (s32)s) return TEST_FAIL;
+                }
+            }
+            if (a.radix != 9) return TEST_FAIL;
+        }
+    }
+
+    /* (A*B)(p) == A(B(p)) for a rotation at radix 14 and a scale at radix 8 */
+    a.radix = 14;
+    a.ID();
+    a.setrotate(0x1234, 0x2345, 0x3456);
+    a.XlateI(10, -20, 30);
+    b.radix = 8;
+    b.ID();
+    b.m00 = I2FR(2, 8);
+    b.m11 = I2FR(3, 8) / 2;
+    b.XlateI(3, -4, 5);
+    c = a;
+    c *= b;
+    if (c.radix != 14 || c.fast || c.proj) return TEST_FAIL;
+    get16(a, x);
+    for (t = 0; t < 50; t++) {
+        s32 p[3] = { rnd(300), rnd(300), rnd(300) }, q[3], e[3], f[3];
+        c.XFormPtI(p[0], p[1], p[2], &q[0], &q[1], &q[2], 0);
+        b.XFormPtI(p[0], p[1], p[2], &e[0], &e[1], &e[2], 0);   /* radix 8 */
+        for (i = 0; i < 3; i++) {
+            s64 v = (s64)e[0] * x[4 * i] + (s64)e[1] * x[4 * i + 1] + (s64)e[2] * x[4 * i + 2];
+            f[i] = (s32)(((v + 128) >> 8) + x[4 * i + 3]);
+            if (q[i] - f[i] > 3 * 300 || f[i] - q[i] > 3 * 300) return TEST_FAIL;
+        }
+    }
+
+    /* identity on either side is exact; self multiply reads the old values */
+    d.radix = 3;
+    d.ID();
+    c = a;
+    c.mul(&d);
+    if (maxdiff(c, a) != 0) return TEST_FAIL;
+    c = a;
+    d = a;
+    c *= c;
+    d.mul(&a);
+    if (maxdiff(c, d) != 0) return TEST_FAIL;
+
+    /* saturation, including four (-2^31)^2 products at radix 0 */
+    for (i = 0; i < 16; i++) x[i] = FR_OVERFLOW_NEG;
+    a.set4x4(x, 0);
+    a *= a;
+    if (a.m00 != FR_OVERFLOW_POS || a.m33 != FR_OVERFLOW_POS) return TEST_FAIL;
+    return TEST_PASS;
+}
+
+/* Test determinant and inverse, affine and projective */
+int test_det_inv() {
+    FR_Matrix3D a(16), b(16), c(16), id(16);
+    s32 x, y, z, x2, y2, z2;
+    int t;
+
+    a.setrotate(0x1000, 0x2800, 0x9000);
+    a.XlateI(100, -200, 50);
+    if (a.det() < I2FR(1, 16) - 8 || a.det() > I2FR(1, 16) + 8) return TEST_FAIL;
+    if (!a.inv(&b)) return TEST_FAIL;
+    if (b.proj || b.m30 || b.m33 != I2FR(1, 16)) return TEST_FAIL;
+    c = a;
+    c *= b;
+    if (maxdiff(c, id) > 96) return TEST_FAIL;                /* translation of 2^23 scale */
+    for (t = 0; t < 50; t++) {
+        s32 px = rnd(1000), py = rnd(1000), pz = rnd(1000);
+        a.XFormPtI(px, py, pz, &x, &y, &z);
+        b.XFormPtI(x, y, z, &x2, &y2, &z2);
+        if (x2 - px > 2 || px - x2 > 2 || y2 - py > 2 || py - y2 > 2 || z2 - pz > 2 || pz - z2 > 2)
+            return TEST_FAIL;
+    }
+
+    /* scale by 2, 4, 1/2 with translation: exact inverse */
+    a.ID();
+    a.m00 = I2FR(2, 16);
+    a.m11 = I2FR(4, 16);
+    a.m22 = I2FR(1, 16) / 2;
+    a.XlateI(8, -4, 2);
+    a.checkfast();
+    if (a.det() != I2FR(4, 16)) return TEST_FAIL;
+    if (!a.inv(&b) || !b.fast) return TEST_FAIL;
+    if (b.m00 != I2FR(1, 16) / 2 || b.m11 != I2FR(1, 16) / 4 || b.m22 != I2FR(2, 16)) return TEST_FAIL;
+    if (b.m03 != -I2FR(4, 16) || b.m13 != I2FR(1, 16) || b.m23 != -I2FR(4, 16)) return TEST_FAIL;
+
+    /* projective: perspective times rotation, inverse times original */
+    a.ID();
+    a.setrotateY(0x0800);
+    a.XlateI(0, 0, 10);
+    b.ID();
+    b.setperspective(256);
+    b *= a;
+    if (!b.proj) return TEST_FAIL;
+    if (!b.inv(&c) || !c.proj) return TEST_FAIL;
+    a = c;
+    a *= b;
+    if (maxdiff(a, id) > 4) return TEST_FAIL;
+
+    /* singular and aliased */
+    a.ID();
+    a.m11 = 0;
+    if (a.det() != 0 || a.inv(&b) || a.inv()) return TEST_FAIL;
+    a.ID();
+    if (a.inv(&a) || a.inv((FR_Matrix3D *)0)) return TEST_FAIL;
+    a.m00 = I2FR(4, 16);
+    if (!a.inv() || a.m00 != I2FR(1, 16) / 4) return TEST_FAIL;
+    return TEST_PASS;
+}
+
+/* Test the perspective divide */
+int test_projection() {
+    FR_Matrix3D m(16);
+    s32 x, y, z;
+
+    m.setperspective(256);
+    if (!m.proj || m.m32 != 256) return TEST_FAIL;
+    /* w = z / 256 + 1 */
+    if (!m.XFormPtIProj(100, 50, 256, &x, &y, &z, 0)) return TEST_FAIL;
+    if (x != 50 || y != 25 || z != 128) return TEST_FAIL;
+    if (!m.XFormPtIProj(100, -50, 0, &x, &y, &z, 4)) return TEST_FAIL;
+    if (x != 1600 || y != -800 || z != 0) return TEST_FAIL;
+    if (!m.XFormPtIProj(1, -1, 512, &x, &y, &z, 0)) return TEST_FAIL;
+    if (x != 0 || y != 0 || z != 171) return TEST_FAIL;       /* 1/3 -> 0, 512/3 -> 171 */
+    if (!m.XFormPtIProj(2, -2, 512, &x, &y, &z, 0)) return TEST_FAIL;
+    if (x != 1 || y != -1) return TEST_FAIL;                  /* 2/3 rounds to 1 */
+
+    /* at and behind the eye */
+    if (m.XFormPtIProj(5, 5, -256, &x, &y, &z, 0)) return TEST_FAIL;
+    if (x != FR_OVERFLOW_NEG || y != FR_OVERFLOW_NEG || z != FR_OVERFLOW_NEG) return TEST_FAIL;
+    if (m.XFormPtIProj(5, 5, -1000, &x, &y, &z, 0)) return TEST_FAIL;
+
+    m.setperspective(0);
+    if (m.proj) return TEST_FAIL;
+    if (!m.XFormPtIProj(7, 8, 9, &x, &y, &z, 0) || x != 7 || y != 8 || z != 9) return TEST_FAIL;
+    return TEST_PASS;
+}
+
+#define XF_N 37
+static s32 g_x[XF_N], g_y[XF_N], g_z[XF_N];
+
+/* batch results match the scalar forms point for point, also in place */
+static int batch_matches(void *ctx) {
+    FR_Matrix3D &m = *(FR_Matrix3D *)ctx;
+    s32 xp[XF_N], yp[XF_N], zp[XF_N], bx[XF_N], by[XF_N], bz[XF_N];
+    u32 i, clip = 0;
+
+    m.XFormPtsI(g_x, g_y, g_z, bx, by, bz, XF_N, 3);
+    for (i = 0; i < XF_N; i++) {
+        m.XFormPtI(g_x[i], g_y[i], g_z[i], &xp[i], &yp[i], &zp[i], 3);
+        if (bx[i] != xp[i] || by[i] != yp[i] || bz[i] != zp[i]) return 0;
+    }
+    memcpy(bx, g_x, sizeof(bx));
+    memcpy(by, g_y, sizeof(by));
+    memcpy(bz, g_z, sizeof(bz));
+    m.XFormPtsI(bx, by, bz, bx, by, bz, XF_N);
+    for (i = 0; i < XF_N; i++) {
+        m.XFormPtI(g_x[i], g_y[i], g_z[i], &xp[i], &yp[i], &zp[i]);
+        if (bx[i] != xp[i] || by[i] != yp[i] || bz[i] != zp[i]) return 0;
+    }
+
+    /* the divide at several output radixes, saturating at r = 21 */
+    static const u16 rs[4] = { 0, 2, 21, 22 };
+    for (u32 j = 0; j < 4; j++) {
+        if (m.XFormPtsIProj(g_x, g_y, g_z, bx, by, bz, XF_N, rs[j]) != 0 && !m.proj) return 0;
+        memcpy(bx, g_x, sizeof(bx));
+        memcpy(by, g_y, sizeof(by));
+        memcpy(bz, g_z, sizeof(bz));
+        u32 got = m.XFormPtsIProj(bx, by, bz, bx, by, bz, XF_N, rs[j]);
+        for (i = 0, clip = 0; i < XF_N; i++) {
+            clip += !m.XFormPtIProj(g_x[i], g_y[i], g_z[i], &xp[i], &yp[i], &zp[i], rs[j]);
+            if (bx[i] != xp[i] || by[i] != yp[i] || bz[i] != zp[i]) return 0;
+        }
+        if (got != clip) return 0;
+    }
+    return 1;
+}
+
+/* Test batch transforms against the scalar forms */
+int test_batch_xform() {
+    FR_Matrix3D m(10);
+    u32 i, pass;
+
+    for (i = 0; i < XF_N; i++) {
+        g_x[i] = rnd(30000);
+        g_y[i] = rnd(30000);
+        g_z[i] = rnd(3000);
+    }
+    for (pass = 0; pass < 3; pass++) {
+        m.ID();
+        if (pass == 0) {
+            m.m00 = I2FR(3, 10) / 2;
+            m.m11 = -I2FR(2, 10);
+            m.m22 = 700;
+            m.XlateI(-40, 7, 1000);
+            m.checkfast();
+        } else {
+            m.setrotate(0x1111, 0x2222, 0x3333);
+            m.XlateI(-12, 250, 4000);
+            m.m00 += 17;                           /* some shear too */
+            if (pass == 2) m.setperspective(2000); /* some points behind the eye */
+        }
+        if (m.fast != (pass == 0) || m.proj != (pass == 2)) return TEST_FAIL;
+        if (!fr_test_simd_levels(batch_matches, &m)) return TEST_FAIL;
+    }
+
+    /* NULL is a no-op */
+    g_x[0] = 5;
+    m.XFormPtsI((const s32 *)0, g_y, g_z, g_x, g_y, g_z, XF_N);
+    if (m.XFormPtsIProj(g_x, g_y, g_z, g_x, g_y, (s32 *)0, XF_N, 0) != 0) return TEST_FAIL;
+    if (g_x[0] != 5) return TEST_FAIL;
+    return TEST_PASS;
+}
+
+int main() {
+    printf("\n=== FR_Math_3D Complete Test Suite ===\n\n");
+
+    printf("Basic Operations:\n");
+    RUN_TEST(test_identity);
+    RUN_TEST(test_rotation_xform);
+
+    printf("\nMatrix Operations:\n");
+    RUN_TEST(test_mul);
+    RUN_TEST(test_det_inv);
+
+    printf("\nProjection:\n");
+    RUN_TEST(test_projection);
+
+    printf("\nOptimizations:\n");
+    RUN_TEST(test_batch_xform);
+
+    printf("\n=== Test Summary ===\n");
+    printf("Total: %d, Passed: %d, Failed: %d\n",
+           test_count, test_count - fail_count, fail_count);
+
+    return fail_count > 0 ? 1 : 0;
+}
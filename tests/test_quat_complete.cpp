@@ -0,0 +1,350 @@
+/*
+ * test_quat_complete.cpp - Complete test coverage for FR_math_quat
+ * Tests the C++ quaternion class and its matrix conversions
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "../src/FR_math_quat.h"
+#include "fr_test_util.h"
+
+#define TEST_PASS 0
+#define TEST_FAIL 1
+
+static int test_count = 0;
+static int fail_count = 0;
+
+#define RUN_TEST(test_func) do { \
+    printf("  %s: ", #test_func); \
+    test_count++; \
+    if (test_func() == TEST_PASS) { \
+        printf("PASS\n"); \
+    } else { \
+        printf("FAIL\n"); \
+        fail_count++; \
+    } \
+} while(0)
+
+#define Q30 1073741824.0
+#define BAM2RAD(b) ((double)(b) * 6.283185307179586 / 65536.0)
+
+static u32 g_seed = 12345u;
+static s32 rnd(s32 lim) {     /* uniform in [-lim, lim) */
+    g_seed = fr_test_lcg(g_seed);
+    return (s32)((g_seed >> 8) % (2u * (u32)lim)) - lim;
+}
+
+/* random unit quaternion (double reference normalised, then rounded) */
+static FR_Quat rndq() {
+    double v[4], n = 0;
+    int i;
+    for (i = 0; i < 4; i++) { v[i] = rnd(1 << 20); n += v[i] * v[i]; }
+    n = sqrt(n);
+    if (n == 0) return FR_Quat();
+    return FR_Quat((s32)floor(v[0] / n * Q30 + 0.5), (s32)floor(v[1] / n * Q30 + 0.5),
+                   (s32)floor(v[2] / n * Q30 + 0.5), (s32)floor(v[3] / n * Q30 + 0.5));
+}
+
+/* max |q - (w, x, y, z)| in s1.30 LSB, reference in double */
+static double qerr(const FR_Quat &q, double w, double x, double y, double z) {
+    double e = fabs(q.w - w * Q30), t;
+    t = fabs(q.x - x * Q30); if (t > e) e = t;
+    t = fabs(q.y - y * Q30); if (t > e) e = t;
+    t = fabs(q.z - z * Q30); if (t > e) e = t;
+    return e;
+}
+
+/* same rotation: q == p or q == -p within tol LSB */
+static int samerot(const FR_Quat &q, const FR_Quat &p, double tol) {
+    return qerr(q, p.w / Q30, p.x / Q30, p.y / Q30, p.z / Q30) <= tol ||
+           qerr(q, -p.w / Q30, -p.x / Q30, -p.y / Q30, -p.z / Q30) <= tol;
+}
+
+static s32 m3diff(const FR_Matrix3D &a, const FR_Matrix3D &b) {
+    const s32 x[9] = { a.m00, a.m01, a.m02, a.m10, a.m11, a.m12, a.m20, a.m21, a.m22 };
+    const s32 y[9] = { b.m00, b.m01, b.m02, b.m10, b.m11, b.m12, b.m20, b.m21, b.m22 };
+    s32 d = 0;
+    int i;
+    for (i = 0; i < 9; i++) {
+        s32 e = x[i] > y[i] ? x[i] - y[i] : y[i] - x[i];
+        if (e > d) d = e;
+    }
+    return d;
+}
+
+/* Test identity, set, conj, dot and normalize */
+int test_basic() {
+    FR_Quat q, p;
+    int i;
+
+    if (q.w != FR_QUAT_ONE || q.x || q.y || q.z) return TEST_FAIL;
+    q.set(1, 2, 3, 4);
+    if (q.w != 1 || q.x != 2 || q.y != 3 || q.z != 4) return TEST_FAIL;
+    q.conj();
+    if (q.w != 1 || q.x != -2 || q.y != -3 || q.z != -4) return TEST_FAIL;
+    q.ID();
+    if (q.dot(&q) != FR_QUAT_ONE) return TEST_FAIL;
+
+    /* dot: exact rounding, saturated */
+    q.set(FR_QUAT_ONE / 2, FR_QUAT_ONE / 2, 3, 0);
+    p.set(FR_QUAT_ONE / 2, -FR_QUAT_ONE / 2, 1 << 29, 0);
+    if (q.dot(&p) != 2) return TEST_FAIL;                 /* 3 * 2^29 / 2^30 = 1.5 -> 2 */
+    q.set(FR_OVERFLOW_NEG, FR_OVERFLOW_NEG, FR_OVERFLOW_NEG, FR_OVERFLOW_NEG);
+    if (q.dot(&q) != FR_OVERFLOW_POS) return TEST_FAIL;
+
+    /* normalize: any length, within 2.5 LSB of the unit vector */
+    for (i = 0; i < 2000; i++) {
+        s32 s = 1 << (i % 31);
+        double w, x, y, z, n;
+        q.set(rnd(s), rnd(s), rnd(s), rnd(s));
+        if (i % 7 == 0) q.x = FR_OVERFLOW_NEG;
+        w = q.w; x = q.x; y = q.y; z = q.z;
+        n = sqrt(w * w + x * x + y * y + z * z);
+        if (n == 0) continue;
+        if (!q.normalize()) return TEST_FAIL;
+        if (qerr(q, w / n, x / n, y / n, z / n) > 2.5) return TEST_FAIL;
+    }
+    q.set(0, 0, -1, 0);
+    if (!q.normalize() || q.y != -FR_QUAT_ONE) return TEST_FAIL;
+    q.set(0, 0, 0, 0);
+    if (q.normalize() || q.w || q.x || q.y || q.z) return TEST_FAIL;
+    return TEST_PASS;
+}
+
+/* Test single axis, axis-angle and Euler rotations */
+int test_rotations() {
+    FR_Quat q, p;
+    FR_Matrix3D m(30), r(30);
+    int i;
+
+    for (i = 0; i < 65536; i += 997) {
+        double h = BAM2RAD(i) / 2;
+        q.setrotateX((u16)i);
+        if (qerr(q, cos(h), sin(h), 0, 0) > 2.0) return TEST_FAIL;
+        q.setrotateY((u16)i);
+        if (qerr(q, cos(h), 0, sin(h), 0) > 2.0) return TEST_FAIL;
+        q.setrotateZ((u16)i);
+        if (qerr(q, cos(h), 0, 0, sin(h)) > 2.0) return TEST_FAIL;
+        /* axis of any length and radix */
+        if (!q.setaxisangle(I2FR(3, 4), 0, -I2FR(4, 4), (u16)i)) return TEST_FAIL;
+        if (qerr(q, cos(h), 0.6 * sin(h), 0, -0.8 * sin(h)) > 4.0) return TEST_FAIL;
+    }
+    p.set(1, 2, 3, 4);
+    if (p.setaxisangle(0, 0, 0, 1000)) return TEST_FAIL;
+    if (p.w != FR_QUAT_ONE || p.x || p.y || p.z) return TEST_FAIL;
+
+    /* Euler order matches FR_Matrix3D::setrotate */
+    for (i = 0; i < 200; i++) {
+        u16 bx = (u16)rnd(32768), by = (u16)rnd(32768), bz = (u16)rnd(32768);
+        q.setrotate(bx, by, bz);
+        q.tomatrix(&m);
+        r.setrotate(bx, by, bz);
+        if (m3diff(m, r) > 16) return TEST_FAIL;
+    }
+    return TEST_PASS;
+}
+
+/* Test the Hamilton product against double and against matrix composition */
+int test_mul() {
+    FR_Quat a, b, c;
+    FR_Matrix3D ma(24), mb(24), mc(24);
+    int i;
+
+    for (i = 0; i < 1000; i++) {
+        double aw, ax, ay, az, bw, bx, by, bz;
+        a = rndq();
+        b = rndq();
+        aw = a.w / Q30; ax = a.x / Q30; ay = a.y / Q30; az = a.z / Q30;
+        bw = b.w / Q30; bx = b.x / Q30; by = b.y / Q30; bz = b.z / Q30;
+        c = a;
+        c *= b;
+        if (qerr(c, aw * bw - ax * bx - ay * by - az * bz,
+                    aw * bx + ax * bw + ay * bz - az * by,
+                    aw * by - ax * bz + ay * bw + az * bx,
+                    aw * bz + ax * by - ay * bx + az * bw) > 1.0) return TEST_FAIL;
+        /* b applied first, as FR_Matrix3D::mul */
+        a.tomatrix(&ma);
+        b.tomatrix(&mb);
+        ma.mul(&mb);
+        c.tomatrix(&mc);
+        if (m3diff(ma, mc) > 2) return TEST_FAIL;
+    }
+    /* aliasing: q *= q is a double rotation */
+    a.setrotateZ(3000);
+    a.mul(&a);
+    b.setrotateZ(6000);
+    if (!samerot(a, b, 4.0)) return TEST_FAIL;
+    /* saturation */
+    a.set(FR_OVERFLOW_NEG, FR_OVERFLOW_NEG, 0, 0);
+    b = a;
+    a.mul(&b);
+    if (a.w != 0 || a.x != FR_OVERFLOW_POS) return TEST_FAIL;      /* 2 * 2^62 / 2^30 */
+    return TEST_PASS;
+}
+
+/* Test tomatrix / frommatrix for FR_Matrix3D and FR_Matrix2D_CPT */
+int test_matrix_convert() {
+    FR_Quat q, p;
+    FR_Matrix3D m(30);
+    FR_Matrix2D_CPT m2(16), r2(16);
+    static const u16 half[6][3] = {               /* near 180 deg: every Shepperd branch */
+        { 32768, 0, 0 }, { 0, 32768, 0 }, { 0, 0, 32768 },
+        { 32700, 100, 0 }, { 50, 32760, 20 }, { 0, 100, 32700 }
+    };
+    int i;
+
+    for (i = 0; i < 1000; i++) {
+        q = rndq();
+        m.radix = 30;
+        m.XlateI(1, 2, 3, 8);
+        q.tomatrix(&m);
+        if (m.m03 != I2FR(1, 8) || m.m23 != I2FR(3, 8)) return TEST_FAIL;  /* kept */
+        if (!p.frommatrix(&m) || p.w < 0) return TEST_FAIL;
+        if (!samerot(p, q, 24.0)) return TEST_FAIL;
+        m.radix = 16;
+        q.tomatrix(&m);
+        if (!p.frommatrix(&m) || !samerot(p, q, 1 << 16)) return TEST_FAIL;
+    }
+    for (i = 0; i < 6; i++) {
+        q.setrotate(half[i][0], half[i][1], half[i][2]);
+        m.radix = 30;
+        q.tomatrix(&m);
+        if (!p.frommatrix(&m) || !samerot(p, q, 24.0)) return TEST_FAIL;
+    }
+
+    /* 2D: rotation about Z both ways */
+    for (i = -180; i <= 180; i += 15) {
+        double h = i * 3.141592653589793 / 360.0;
+        r2.setrotate((s16)i);
+        if (!q.frommatrix(&r2)) return TEST_FAIL;
+        if (q.x || q.y) return TEST_FAIL;
+        if (!samerot(q, FR_Quat((s32)(cos(h) * Q30), 0, 0, (s32)(sin(h) * Q30)), 1 << 17)) return TEST_FAIL;
+        q.setaxisangle(0, 0, 1, (u16)(i * 65536 / 360));
+        m2.XlateI(5, -5);
+        q.tomatrix(&m2);
+        if (m2.m02 != I2FR(5, 16) || m2.m12 != -I2FR(5, 16)) return TEST_FAIL;
+        if (labs((long)(m2.m00 - r2.m00)) > 8 || labs((long)(m2.m01 - r2.m01)) > 8 ||
+            labs((long)(m2.m10 - r2.m10)) > 8 || labs((long)(m2.m11 - r2.m11)) > 8) return TEST_FAIL;
+    }
+    if (q.frommatrix((const FR_Matrix3D *)0) || q.w != FR_QUAT_ONE) return TEST_FAIL;
+    q.tomatrix((FR_Matrix3D *)0);
+    return TEST_PASS;
+}
+
+/* double slerp reference, shorter arc */
+static void ref_slerp(const FR_Quat &a, const FR_Quat &b, double t, double *o) {
+    double A[4] = { a.w / Q30, a.x / Q30, a.y / Q30, a.z / Q30 };
+    double B[4] = { b.w / Q30, b.x / Q30, b.y / Q30, b.z / Q30 };
+    double d = A[0] * B[0] + A[1] * B[1] + A[2] * B[2] + A[3] * B[3], h, ka, kb;
+    int i;
+    if (d < 0) { d = -d; for (i = 0; i < 4; i++) B[i] = -B[i]; }
+    if (d > 1) d = 1;
+    h = acos(d);
+    if (h < 1e-9) { ka = 1 - t; kb = t; }
+    else { ka = sin((1 - t) * h) / sin(h); kb = sin(t * h) / sin(h); }
+    for (i = 0; i < 4; i++) o[i] = ka * A[i] + kb * B[i];
+}
+
+/* Test nlerp and slerp */
+int test_interp() {
+    FR_Quat a, b, q;
+    double o[4], n;
+    int i, j;
+
+    for (i = 0; i < 500; i++) {
+        a = rndq();
+        b = rndq();
+        if (i % 5 == 0) {                      /* close pairs take the nlerp path */
+            FR_Quat d;
+            d.setaxisangle(rnd(1000), rnd(1000), rnd(1000) + 1, (u16)(i % 40));
+            b = a;
+            b.mul(&d);
+        }
+        for (j = 0; j <= 16; j++) {
+            q.slerp(&a, &b, j << 12, 16);
+            ref_slerp(a, b, j / 16.0, o);
+            if (qerr(q, o[0], o[1], o[2], o[3]) > 64.0) return TEST_FAIL;
+            q.nlerp(&a, &b, j << 12, 16);
+            n = q.dot(&q) / Q30;
+            if (fabs(n - 1.0) > 8.0 / Q30) return TEST_FAIL;
+        }
+        /* exact ends and clamping */
+        q.slerp(&a, &b, 0, 16);
+        if (memcmp(&q, &a, sizeof(q))) return TEST_FAIL;
+        q.slerp(&a, &b, -5, 16);
+        if (memcmp(&q, &a, sizeof(q))) return TEST_FAIL;
+        q.slerp(&a, &b, 1 << 16, 16);
+        if (!samerot(q, b, 0.0)) return TEST_FAIL;
+        q.nlerp(&a, &b, 1 << 20, 16);
+        if (!samerot(q, b, 0.0)) return TEST_FAIL;
+    }
+    /* shorter arc: -b is the same rotation */
+    a.setrotateZ(0);
+    b.setrotateZ(16384);
+    q = b;
+    q.w = -q.w; q.x = -q.x; q.y = -q.y; q.z = -q.z;
+    q.slerp(&a, &q, 1 << 15, 16);
+    b.setrotateZ(8192);
+    if (qerr(q, b.w / Q30, 0, 0, b.z / Q30) > 16.0) return TEST_FAIL;
+    /* aliasing: this may be a or b */
+    a.setrotateX(0);
+    q.setrotateX(20000);
+    q.slerp(&a, &q, 1 << 15, 16);
+    b.setrotateX(10000);
+    if (qerr(q, b.w / Q30, b.x / Q30, 0, 0) > 16.0) return TEST_FAIL;
+    return TEST_PASS;
+}
+
+/* Test fr_quat_slerp_array: same as slerp, repeated pairs, aliasing */
+#define SL_N 97
+int test_slerp_array() {
+    static FR_Quat ka[SL_N], kb[SL_N], out[SL_N], ref[SL_N];
+    static s32 t[SL_N];
+    int i;
+
+    for (i = 0; i < SL_N; i++) {
+        if (i % 8 == 0) {                      /* a track: 8 samples per key pair */
+            ka[i] = rndq();
+            kb[i] = rndq();
+        } else {
+            ka[i] = ka[i - 1];
+            kb[i] = kb[i - 1];
+        }
+        t[i] = (i % 8) << 13;
+        if (i == 40) t[i] = 1 << 16;
+        if (i == 41) t[i] = -1;
+        ref[i].slerp(&ka[i], &kb[i], t[i], 16);
+    }
+    fr_quat_slerp_array(ka, kb, t, out, SL_N, 16);
+    if (memcmp(out, ref, sizeof(ref))) return TEST_FAIL;
+    fr_quat_slerp_array(ka, kb, t, ka, SL_N, 16);      /* out over a */
+    if (memcmp(ka, ref, sizeof(ref))) return TEST_FAIL;
+    out[0].set(1, 2, 3, 4);
+    fr_quat_slerp_array((const FR_Quat *)0, kb, t, out, SL_N, 16);
+    fr_quat_slerp_array(kb, kb, (const s32 *)0, out, SL_N, 16);
+    if (out[0].w != 1) return TEST_FAIL;
+    return TEST_PASS;
+}
+
+int main() {
+    printf("\n=== FR_math_quat Complete Coverage Tests ===\n\n");
+
+    printf("Basic operations:\n");
+    RUN_TEST(test_basic);
+    RUN_TEST(test_rotations);
+
+    printf("\nComposition and conversion:\n");
+    RUN_TEST(test_mul);
+    RUN_TEST(test_matrix_convert);
+
+    printf("\nInterpolation:\n");
+    RUN_TEST(test_interp);
+    RUN_TEST(test_slerp_array);
+
+    printf("\n=== Results ===\n");
+    printf("Tests run: %d\n", test_count);
+    printf("Tests passed: %d\n", test_count - fail_count);
+    printf("Tests failed: %d\n", fail_count);
+    return fail_count > 0 ? 1 : 0;
+}
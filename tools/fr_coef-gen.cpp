@@ -27,6 +27,7 @@
  */
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include "math.h"
 
@@ -171,9 +172,56 @@ void gen_trigTable(const char *tabname, double start, double end, double inc, lo
 		printf("#define %s_SZMASK (0x%x)\n\n",tabname,k-1);
 	}
 }
-int main (void)
+/* Windowed-sinc (Hamming) low-pass taps for fr_fir_t, at radix prec.
+ * cutoff is a fraction of the sample rate (0 < cutoff < 0.5); gain is the
+ * DC gain (1 for plain filtering, L for an fr_fir_interpolate by L).
+ * Taps are rounded, then the centre tap absorbs the rounding so the taps
+ * sum to exactly gain << prec. */
+void gen_firLowpass(const char *name, int ntaps, double cutoff, int prec, int gain=1)
+{
+	double h[1024], sum = 0, m = (ntaps - 1) / 2.0;
+	long   q[1024], qsum = 0, target = (long)gain << prec;
+	int i;
+	if (ntaps < 1 || ntaps > 1024)
+		return;
+	for (i = 0; i < ntaps; i++)
+	{
+		double t = i - m;
+		double s = (t == 0) ? 2.0 * cutoff : sin(2.0 * LCL_PI * cutoff * t) / (LCL_PI * t);
+		double w = (ntaps > 1) ? 0.54 - 0.46 * cos(2.0 * LCL_PI * i / (ntaps - 1)) : 1.0;
+		h[i] = s * w;
+		sum += h[i];
+	}
+	for (i = 0; i < ntaps; i++)
+	{
+		q[i] = lround(h[i] / sum * (double)target);
+		qsum += q[i];
+	}
+	q[ntaps / 2] += target - qsum;
+	printf("/* %d-tap low-pass, cutoff %.4f fs, Hamming, DC gain %d, radix %d */\n",
+	       ntaps, cutoff, gain, prec);
+	printf("static const s32 %s[%d] = {\n  ", name, ntaps);
+	for (i = 0; i < ntaps; i++)
+	{
+		printf("%7ld", q[i]);
+		if (i + 1 < ntaps)
+			printf((i % 8 == 7) ? ",\n  " : ", ");
+	}
+	printf("\n};\n");
+}
+
+int main (int argc, char **argv)
 {
 	int prec = 16;
+
+	/* fr_coef-gen fir <ntaps> <cutoff> [radix] [gain] [name] */
+	if (argc >= 4 && !strcmp(argv[1], "fir"))
+	{
+		gen_firLowpass((argc > 6) ? argv[6] : "gFIR_LP", atoi(argv[2]), atof(argv[3]),
+		               (argc > 4) ? atoi(argv[4]) : prec, (argc > 5) ? atoi(argv[5]) : 1);
+		return 0;
+	}
+
 	gen_coef("coef_r2d",57.29577951308232087679,prec);
 	gen_coef("coef_e",2.718281828459045235360,prec);
 	gen_coef("coef_r_e",0.367879441171442321595,prec);
@@ -0,0 +1,62 @@
+#!/usr/bin/env python3
+"""Generate the size-selectable lookup tables in FR_math.c.
+
+Emits one #if / #elif chain per table, covering every supported value of
+the FR_TRIG_TABLE_BITS and FR_LOG_TABLE_BITS build knobs:
+
+  gFR_SIN_TAB_Q       sin over [0, pi/2], u0.15, 2^T + 1 entries
+  gFR_TAN_TAB_O       tan over [0, pi/4], u0.15, 2^(T-1) + 1 entries
+  gFR_ATAN_TAB_O      atan over [0, 1],   u0.16 radians, 2^(T-1) + 1 entries
+  gFR_POW2_FRAC_TAB   2^f over [0, 1],    s.16,  2^L + 1 entries
+  gFR_LOG2_MANT_TAB   log2(m) over [1, 2], s.16, 2^L + 1 entries
+
+where T = FR_TRIG_TABLE_BITS (6..9) and L = FR_LOG_TABLE_BITS (5..8).
+Paste the output over the matching blocks in FR_math.c.
+"""
+import math
+
+TRIG_BITS = [6, 7, 8, 9]
+LOG_BITS = [5, 6, 7, 8]
+
+
+def emit(name, ctype, size, knob, bits_list, width, fn):
+    for k, bits in enumerate(bits_list):
+        n = 1 << bits
+        entries = [fn(i, n) for i in range(n + 1)]
+        print(f"#{'if' if k == 0 else 'elif'} {knob} == {bits}")
+        print(f"static const {ctype} {name}[{size}] = {{  /* {n + 1} entries */")
+        for row in range(0, n + 1, 8):
+            chunk = entries[row:row + 8]
+            vals = ", ".join(f"{v:{width}d}" for v in chunk)
+            comma = "," if row + 8 <= n else ""
+            print(f"    {vals}{comma}")
+        print("};")
+    print("#endif")
+    print()
+
+
+sin_q = lambda i, n: round(math.sin(i * (math.pi / 2) / n) * 32768)
+tan_o = lambda i, n: round(math.tan(i * (math.pi / 4) / n) * 32768)
+atan_o = lambda i, n: round(math.atan(i / n) * 65536)
+pow2 = lambda i, n: round(2.0 ** (i / n) * 65536)
+log2m = lambda i, n: round(math.log2(1 + i / n) * 65536)
+
+emit("gFR_SIN_TAB_Q", "unsigned short", "FR_TRIG_TABLE_SIZE", "FR_TRIG_TABLE_BITS", TRIG_BITS, 5, sin_q)
+emit("gFR_TAN_TAB_O", "unsigned short", "FR_TAN_TABLE_SIZE", "FR_TAN_TABLE_BITS",
+     [b - 1 for b in TRIG_BITS], 5, tan_o)
+emit("gFR_ATAN_TAB_O", "unsigned short", "FR_TAN_TABLE_SIZE", "FR_TAN_TABLE_BITS",
+     [b - 1 for b in TRIG_BITS], 5, atan_o)
+emit("gFR_POW2_FRAC_TAB", "u32", "FR_LOG_TABLE_SIZE", "FR_LOG_TABLE_BITS", LOG_BITS, 6, pow2)
+emit("gFR_LOG2_MANT_TAB", "u32", "FR_LOG_TABLE_SIZE", "FR_LOG_TABLE_BITS", LOG_BITS, 5, log2m)
+
+# Verify the default sizes still match the historical tables
+assert sin_q(1, 128) == 402 and sin_q(121, 128) == 32647 and sin_q(128, 128) == 32768
+assert tan_o(1, 64) == 402 and tan_o(64, 64) == 32768
+assert atan_o(64, 64) == 51472                  # pi/4 at r16, fits u16
+assert pow2(32, 64) == 92682 and pow2(64, 64) == 131072
+assert log2m(1, 64) == 1466 and log2m(64, 64) == 65536
+# Worst-case tan step must fit the s32 interpolation product (d * frac << 4)
+for b in TRIG_BITS:
+    n = 1 << (b - 1)
+    assert (tan_o(n, n) - tan_o(n - 1, n)) << (13 - (b - 1) + 4) < 2 ** 31
+print("/* Verification passed. */")
@@ -0,0 +1,31 @@
+#!/usr/bin/env python3
+"""Generate gFR_SIN32_TAB[257] for fr_sin_bam32 / fr_cos_bam32.
+
+Output: sin(i * (pi/2) / 256) at s1.30 fixed point, for i = 0..256.
+Entry 256 - i is the matching cosine, so one table serves both.
+Paste directly into FR_math.c.
+"""
+import math
+
+N = 256
+ONE = 1 << 30
+entries = [round(math.sin(i * (math.pi / 2) / N) * ONE) for i in range(N + 1)]
+
+print(f"static const u32 gFR_SIN32_TAB[{N+1}] = {{")
+for row in range(0, N + 1, 6):
+    chunk = entries[row:row+6]
+    vals = ", ".join(f"{v:10d}" for v in chunk)
+    comma = "," if row + 6 <= N else ""
+    print(f"    {vals}{comma}")
+print("};")
+print(f"\n/* Size: {(N+1)*4} bytes.  Entry i = round(sin(i*pi/{2*N}) * 2^30). */")
+
+# d = (pi/2) * f / 2^30 radians for the 22-bit sub-interval fraction f;
+# in Q36 that is D = (f * round(pi * 2^30)) >> 25.
+print(f"\n#define FR_TRIG32_PI_Q30  ({round(math.pi * (1 << 30))}u)  /* pi * 2^30 */")
+
+# Verify
+assert entries[0] == 0,         f"first entry should be 0, got {entries[0]}"
+assert entries[N] == ONE,       f"last entry should be 2^30, got {entries[N]}"
+assert entries[N // 2] == 759250125, f"midpoint (sin pi/4) should be 759250125, got {entries[N // 2]}"
+print("Verification passed.")